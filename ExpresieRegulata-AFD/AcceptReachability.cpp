@@ -0,0 +1,66 @@
+﻿#include "AcceptReachability.h"
+#include <algorithm>
+
+AcceptReachability::AcceptReachability()
+    : coreachable(1, 0), stride(1) {
+}
+
+bool AcceptReachability::fromAutomaton(const CompiledAutomaton& forward, const DeterminizeLimits& limits,
+    AcceptReachability& result) {
+    const uint32_t forwardStates = forward.getStateCount();
+    const LambdaNFA nfa = LambdaNFA::fromAutomaton(forward).reversed().unanchored();
+    SubsetConstruction construction;
+    if (!nfa.determinize(limits, construction)) {
+        return false;
+    }
+    const uint32_t dfaStates = static_cast<uint32_t>(construction.sets.size());
+
+    AcceptReachability reachability;
+    reachability.reverse = CompiledAutomaton(dfaStates + 1, 1, construction.classes);
+    for (const auto& transition : construction.transitions) {
+        reachability.reverse.setClassTransition(transition.from + 1, transition.byteClass, transition.to + 1);
+    }
+    reachability.reverse.mergeEquivalentClasses();
+
+    const size_t stride = (forwardStates + 63) / 64;
+    reachability.stride = stride;
+    reachability.coreachable.assign(static_cast<size_t>(dfaStates + 1) * stride, 0);
+    for (uint32_t id = 0; id < dfaStates; ++id) {
+        uint64_t* row = reachability.coreachable.data() + static_cast<size_t>(id + 1) * stride;
+        construction.sets[id].forEach([&](uint32_t state) {
+            // Starile adaugate de reversed si unanchored nu sunt ale lui `forward`
+            if (state < forwardStates) row[state >> 6] |= uint64_t(1) << (state & 63);
+        });
+    }
+
+    result = std::move(reachability);
+    return true;
+}
+
+AcceptReachability::Scan::Scan(const AcceptReachability& reachability, std::string_view text)
+    : reachability(reachability), text(text), base(0) {
+    const CompiledAutomaton& reverse = reachability.reverse;
+    checkpoints.resize(text.size() / kWindow + 1);
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    uint32_t state = reverse.getStartState();
+    for (size_t i = text.size(); ; --i) {
+        if (i % kWindow == 0) checkpoints[i / kWindow] = state;
+        if (i == 0) break;
+        state = reverse.next(state, data[i - 1]);
+    }
+}
+
+void AcceptReachability::Scan::load(size_t window) {
+    const CompiledAutomaton& reverse = reachability.reverse;
+    base = window * kWindow;
+    const size_t last = std::min(base + kWindow, text.size());
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    states.resize(last - base + 1);
+
+    uint32_t state = last == text.size() ? reverse.getStartState() : checkpoints[window + 1];
+    states[last - base] = state;
+    for (size_t i = last; i > base; --i) {
+        state = reverse.next(state, data[i - 1]);
+        states[i - 1 - base] = state;
+    }
+}
@@ -0,0 +1,67 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "CompiledAutomaton.h"
+#include "LambdaNFA.h"
+
+// Pentru un AFD `forward`: automatul Σ*·oglindit(forward), construit peste starile
+// lui `forward`, care citeste textul de la sfarsit. Starea lui la pozitia k da
+// multimea starilor lui `forward` din care textul de la k mai duce intr-o stare
+// finala. O rulare a lui `forward` care iese din multime nu mai poate accepta,
+// deci cea mai lunga potrivire se afla fara a citi dincolo de ultima stare finala
+// (acelasi efect ca memorarea perechilor (stare, pozitie) esuate la Reps).
+//
+// Nu se minimizeaza: stari echivalente ca limbaj pot avea multimi diferite.
+// Automatul invers poate fi exponential in `forward`, deci se construieste cu limite.
+class AcceptReachability {
+public:
+    static constexpr size_t kWindow = 1 << 16;
+
+    // Starile lui reverse pe un text, fereastra cu fereastra: trecerea de la
+    // sfarsit retine doar starea de la fiecare multiplu de kWindow, iar fereastra
+    // ceruta se recalculeaza din punctul ei de control. Memoria nu depinde deci de
+    // marimea textului, iar fiecare octet e citit de cel mult doua ori.
+    class Scan {
+    public:
+        Scan(const AcceptReachability& reachability, std::string_view text);
+
+        // Starea automatului invers la `position`
+        uint32_t at(size_t position) {
+            if (position < base || position - base >= states.size()) load(position / kWindow);
+            return states[position - base];
+        }
+        // Din forwardState, textul de la `position` mai duce intr-o stare finala
+        bool canAccept(size_t position, uint32_t forwardState) {
+            return reachability.canAccept(at(position), forwardState);
+        }
+
+    private:
+        void load(size_t window);
+
+        const AcceptReachability& reachability;
+        std::string_view text;
+        std::vector<uint32_t> checkpoints; // starea la pozitia i * kWindow
+        std::vector<uint32_t> states;      // pozitiile [base, base + kWindow], in limitele textului
+        size_t base;
+    };
+
+    // Fara stari: nicio stare nu mai poate accepta
+    AcceptReachability();
+    // Fals daca automatul invers depaseste limitele
+    static bool fromAutomaton(const CompiledAutomaton& forward, const DeterminizeLimits& limits,
+        AcceptReachability& result);
+
+    const CompiledAutomaton& getAutomaton() const { return reverse; }
+    uint32_t getStateCount() const { return reverse.getStateCount(); }
+    bool canAccept(uint32_t reverseState, uint32_t forwardState) const {
+        return (coreachable[reverseState * stride + (forwardState >> 6)] >> (forwardState & 63)) & 1;
+    }
+
+private:
+    CompiledAutomaton reverse;
+    // Bitul [stare reverse][stare forward]; randul starii moarte 0 e gol
+    std::vector<uint64_t> coreachable;
+    size_t stride;
+};
@@ -0,0 +1,262 @@
+﻿#include "AutomatonEquivalence.h"
+#include "DeterministicFiniteAutomaton.h"
+#include <algorithm>
+#include <bitset>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+// Cate un octet reprezentativ pentru fiecare pereche (clasa in a, clasa in b)
+std::vector<unsigned char> jointRepresentatives(const CompiledAutomaton& a, const CompiledAutomaton& b) {
+    std::vector<uint32_t> keys(CompiledAutomaton::kAlphabetSize);
+    for (uint32_t byte = 0; byte < CompiledAutomaton::kAlphabetSize; ++byte) {
+        const unsigned char symbol = static_cast<unsigned char>(byte);
+        keys[byte] = (a.getByteClasses().classOf(symbol) << 16) | (b.getByteClasses().classOf(symbol) << 8) | byte;
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<unsigned char> bytes;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (i == 0 || (keys[i] >> 8) != (keys[i - 1] >> 8)) bytes.push_back(static_cast<unsigned char>(keys[i]));
+    }
+    return bytes;
+}
+
+class UnionFind {
+public:
+    explicit UnionFind(uint32_t count) : parent(count) {
+        for (uint32_t i = 0; i < count; ++i) parent[i] = i;
+    }
+
+    uint32_t find(uint32_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // Fals daca erau deja in aceeasi clasa
+    bool unite(uint32_t x, uint32_t y) {
+        x = find(x);
+        y = find(y);
+        if (x == y) return false;
+        parent[x] = y;
+        return true;
+    }
+
+private:
+    std::vector<uint32_t> parent;
+};
+
+// Pereche vizitata, cu drumul inapoi spre perechea initiala pentru contraexemplu
+struct Visit {
+    uint32_t p;
+    uint32_t q;
+    uint32_t previous;
+    unsigned char byte;
+};
+
+constexpr uint32_t kNoPrevious = UINT32_MAX;
+
+std::string pathTo(const std::vector<Visit>& visits, uint32_t index) {
+    std::string word;
+    for (; visits[index].previous != kNoPrevious; index = visits[index].previous) {
+        word += static_cast<char>(visits[index].byte);
+    }
+    std::reverse(word.begin(), word.end());
+    return word;
+}
+
+}
+
+bool AreEquivalent(const CompiledAutomaton& a, const CompiledAutomaton& b, std::string* counterexample) {
+    const std::vector<unsigned char> bytes = jointRepresentatives(a, b);
+    const uint32_t offset = a.getStateCount();
+    UnionFind classes(a.getStateCount() + b.getStateCount());
+
+    std::vector<Visit> visits;
+    std::vector<uint32_t> pending;
+    classes.unite(a.getStartState(), offset + b.getStartState());
+    visits.push_back({ a.getStartState(), b.getStartState(), kNoPrevious, 0 });
+    pending.push_back(0);
+
+    // Fiecare unire reduce numarul de clase, deci sunt cel mult |a| + |b| - 1 perechi
+    size_t head = 0;
+    while (head < pending.size()) {
+        const uint32_t index = pending[head++];
+        const Visit visit = visits[index];
+        if (a.isAccepting(visit.p) != b.isAccepting(visit.q)) {
+            if (counterexample) *counterexample = pathTo(visits, index);
+            return false;
+        }
+        for (unsigned char byte : bytes) {
+            const uint32_t p = a.next(visit.p, byte);
+            const uint32_t q = b.next(visit.q, byte);
+            if (classes.unite(p, offset + q)) {
+                visits.push_back({ p, q, index, byte });
+                pending.push_back(static_cast<uint32_t>(visits.size() - 1));
+            }
+        }
+    }
+    return true;
+}
+
+bool IsIncluded(const CompiledAutomaton& a, const CompiledAutomaton& b, std::string* counterexample) {
+    const std::vector<unsigned char> bytes = jointRepresentatives(a, b);
+
+    std::vector<Visit> visits;
+    std::unordered_set<uint64_t> seen;
+    auto key = [](uint32_t p, uint32_t q) { return (static_cast<uint64_t>(p) << 32) | q; };
+    visits.push_back({ a.getStartState(), b.getStartState(), kNoPrevious, 0 });
+    seen.insert(key(a.getStartState(), b.getStartState()));
+
+    // `visits` creste pe parcurs, deci functioneaza ca o coada BFS
+    for (uint32_t index = 0; index < visits.size(); ++index) {
+        const Visit visit = visits[index];
+        if (a.isAccepting(visit.p) && !b.isAccepting(visit.q)) {
+            if (counterexample) *counterexample = pathTo(visits, index);
+            return false;
+        }
+        for (unsigned char byte : bytes) {
+            const uint32_t p = a.next(visit.p, byte);
+            // Din starea moarta a lui a nu se mai accepta nimic
+            if (p == CompiledAutomaton::kDeadState) continue;
+            const uint32_t q = b.next(visit.q, byte);
+            if (seen.insert(key(p, q)).second) {
+                visits.push_back({ p, q, index, byte });
+            }
+        }
+    }
+    return true;
+}
+
+uint64_t CanonicalHash(const CompiledAutomaton& automaton) {
+    // Starile se renumeroteaza in ordinea parcurgerii in latime pe octetii 0..255
+    std::vector<uint32_t> order(automaton.getStateCount(), kNoPrevious);
+    std::vector<uint32_t> queue;
+    std::vector<uint32_t> row(CompiledAutomaton::kAlphabetSize + 1);
+    order[CompiledAutomaton::kDeadState] = 0;
+    order[automaton.getStartState()] = 1;
+    queue.push_back(automaton.getStartState());
+
+    uint64_t hash = HashBytes(nullptr, 0);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const uint32_t state = queue[head];
+        if (state == CompiledAutomaton::kDeadState) {
+            continue;
+        }
+        row[0] = automaton.isAccepting(state);
+        for (uint32_t byte = 0; byte < CompiledAutomaton::kAlphabetSize; ++byte) {
+            const uint32_t target = automaton.next(state, static_cast<unsigned char>(byte));
+            if (order[target] == kNoPrevious) {
+                order[target] = static_cast<uint32_t>(queue.size() + 1);
+                queue.push_back(target);
+            }
+            row[byte + 1] = order[target];
+        }
+        hash = HashBytes(row.data(), row.size() * sizeof(uint32_t), hash);
+    }
+    return hash;
+}
+
+bool ReduceRules(const std::vector<std::string>& expressions, const DeterminizeLimits& limits, RuleReduction& result) {
+    struct Rule {
+        CompiledAutomaton automaton;
+        bool comparable = false;
+        bool acceptsEmpty = false;
+        std::bitset<256> firstBytes; // octetii cu care incep cuvintele limbajului
+    };
+
+    std::vector<Rule> rules(expressions.size());
+    for (size_t i = 0; i < expressions.size(); ++i) {
+        LambdaNFA nfa;
+        if (!LambdaNFA::fromExpression(expressions[i], nfa)) {
+            std::cerr << "Eroare: Expresia " << i << " (" << expressions[i] << ") este invalida.\n";
+            return false;
+        }
+        // Dupa minimizare orice tranzitie in afara starii moarte duce spre un cuvant acceptat
+        Rule& rule = rules[i];
+        if (!nfa.toMinimalAutomaton(limits, rule.automaton)) {
+            continue;
+        }
+        rule.comparable = true;
+        const uint32_t start = rule.automaton.getStartState();
+        rule.acceptsEmpty = rule.automaton.isAccepting(start);
+        for (uint32_t byte = 0; byte < CompiledAutomaton::kAlphabetSize; ++byte) {
+            if (rule.automaton.next(start, static_cast<unsigned char>(byte)) != CompiledAutomaton::kDeadState) {
+                rule.firstBytes.set(byte);
+            }
+        }
+    }
+
+    RuleReduction reduction;
+    std::vector<uint32_t> distinct;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> byHash;
+    for (uint32_t i = 0; i < rules.size(); ++i) {
+        if (!rules[i].comparable) {
+            reduction.unchecked.push_back(i);
+            continue;
+        }
+        std::vector<uint32_t>& bucket = byHash[CanonicalHash(rules[i].automaton)];
+        auto same = std::find_if(bucket.begin(), bucket.end(), [&](uint32_t other) {
+            return AreEquivalent(rules[other].automaton, rules[i].automaton);
+        });
+        if (same != bucket.end()) {
+            reduction.removed.push_back({ i, *same, RuleReduction::Reason::Duplicate });
+        }
+        else {
+            bucket.push_back(i);
+            distinct.push_back(i);
+        }
+    }
+
+    // Intre reguli distincte incluziunea e stricta, deci nu exista cicluri:
+    // regulile maximale raman si fiecare regula eliminata e inclusa intr-una dintre ele
+    auto includes = [&](uint32_t outer, uint32_t inner) {
+        const Rule& a = rules[inner];
+        const Rule& b = rules[outer];
+        if (a.acceptsEmpty && !b.acceptsEmpty) return false;
+        if ((a.firstBytes & ~b.firstBytes).any()) return false;
+        return IsIncluded(a.automaton, b.automaton);
+    };
+    std::vector<uint32_t> subsumedBy(rules.size(), kNoPrevious);
+    for (uint32_t inner : distinct) {
+        for (uint32_t outer : distinct) {
+            if (outer != inner && includes(outer, inner)) {
+                subsumedBy[inner] = outer;
+                break;
+            }
+        }
+    }
+    // Containerul gasit poate fi si el eliminat; se cauta unul care ramane
+    for (uint32_t inner : distinct) {
+        if (subsumedBy[inner] == kNoPrevious) continue;
+        for (uint32_t outer : distinct) {
+            if (subsumedBy[outer] == kNoPrevious && includes(outer, inner)) {
+                reduction.removed.push_back({ inner, outer, RuleReduction::Reason::Subsumed });
+                subsumedBy[inner] = outer;
+                break;
+            }
+        }
+    }
+    // Duplicatele unei reguli eliminate sunt incluse in acelasi container
+    for (auto& removed : reduction.removed) {
+        if (removed.reason == RuleReduction::Reason::Duplicate && subsumedBy[removed.keptBy] != kNoPrevious) {
+            removed = { removed.index, subsumedBy[removed.keptBy], RuleReduction::Reason::Subsumed };
+        }
+    }
+    std::sort(reduction.removed.begin(), reduction.removed.end(),
+        [](const RuleReduction::Removed& x, const RuleReduction::Removed& y) { return x.index < y.index; });
+
+    std::vector<uint8_t> isRemoved(rules.size(), 0);
+    for (const auto& removed : reduction.removed) isRemoved[removed.index] = 1;
+    for (uint32_t i = 0; i < rules.size(); ++i) {
+        if (!isRemoved[i]) reduction.kept.push_back(i);
+    }
+
+    result = std::move(reduction);
+    return true;
+}
@@ -0,0 +1,45 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CompiledAutomaton.h"
+#include "LambdaNFA.h"
+
+// Comparatii intre limbajele a doua AFD compilate. Perechile de stari se
+// genereaza la cerere, pornind din starile initiale; automatul produs nu este
+// construit. Octetii se parcurg pe clasele comune celor doua harti de clase.
+// Daca raspunsul este fals si `counterexample` e dat, primeste cel mai scurt
+// cuvant gasit care le deosebeste.
+
+// L(a) = L(b), prin algoritmul Hopcroft-Karp: perechile se unesc intr-o
+// structura union-find, deci se exploreaza cel mult |a| + |b| - 1 perechi
+bool AreEquivalent(const CompiledAutomaton& a, const CompiledAutomaton& b, std::string* counterexample = nullptr);
+
+// L(a) ⊆ L(b): parcurgere in latime a perechilor accesibile (p, q), oprita la
+// prima pereche cu p final si q nefinal. Pentru incluziune unirea claselor nu
+// aduce nimic, deci se viziteaza cel mult |a| * |b| perechi, de obicei mult mai putine.
+bool IsIncluded(const CompiledAutomaton& a, const CompiledAutomaton& b, std::string* counterexample = nullptr);
+
+// Acelasi rezultat pentru AFD minimale izomorfe (deci cu acelasi limbaj);
+// numerotarea starilor si hartile de clase nu conteaza
+uint64_t CanonicalHash(const CompiledAutomaton& automaton);
+
+// Rezultatul lui ReduceRules; indicii sunt pozitii in lista de expresii
+struct RuleReduction {
+    enum class Reason { Duplicate, Subsumed };
+    struct Removed {
+        uint32_t index;
+        uint32_t keptBy; // o regula pastrata echivalenta cu (sau care include) regula eliminata
+        Reason reason;
+    };
+
+    std::vector<uint32_t> kept;
+    std::vector<Removed> removed;
+    // Reguli pastrate fara comparatie, pentru ca AFD-ul lor depaseste limitele
+    std::vector<uint32_t> unchecked;
+};
+
+// Elimina regulile echivalente cu una anterioara si pe cele incluse strict in
+// alta regula. Duplicatele se grupeaza dupa CanonicalHash, deci doar
+// incluziunile se verifica pe perechi. Fals daca o expresie e invalida.
+bool ReduceRules(const std::vector<std::string>& expressions, const DeterminizeLimits& limits, RuleReduction& result);
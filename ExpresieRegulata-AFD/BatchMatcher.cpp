@@ -0,0 +1,172 @@
+﻿#include "BatchMatcher.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+// Cuvintele trec prin matchesBatch in grupuri de aceasta marime
+constexpr size_t kGroupSize = 1024;
+
+unsigned resolveThreadCount(unsigned threadCount) {
+    if (threadCount != 0) return threadCount;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Pozitia de dupa primul '\n' de la `position` incolo, sau size
+size_t nextLineStart(const char* data, size_t size, size_t position) {
+    if (position >= size) return size;
+    const void* newline = std::memchr(data + position, '\n', size - position);
+    return newline ? static_cast<size_t>(static_cast<const char*>(newline) - data) + 1 : size;
+}
+
+}
+
+BatchMatcher::BatchMatcher(const CompiledAutomaton& automaton) : automaton(automaton) {
+}
+
+void BatchMatcher::processLines(const char* data, size_t size, Output mode, Worker& worker) const {
+    worker.output.clear();
+    worker.wordCount = 0;
+    worker.acceptedCount = 0;
+    worker.words.reserve(kGroupSize);
+    worker.results.resize((kGroupSize + 63) / 64);
+
+    auto flush = [&] {
+        automaton.matchesBatch(worker.words.data(), worker.words.size(), worker.results.data());
+        for (size_t i = 0; i < worker.words.size(); ++i) {
+            const bool accepted = (worker.results[i >> 6] >> (i & 63)) & 1;
+            worker.acceptedCount += accepted;
+            if (mode == Output::Flags) {
+                worker.output += accepted ? "1\n" : "0\n";
+            }
+            else if (mode == Output::Accepted && accepted) {
+                worker.output.append(worker.words[i].data(), worker.words[i].size());
+                worker.output += '\n';
+            }
+        }
+        worker.wordCount += worker.words.size();
+        worker.words.clear();
+    };
+
+    size_t position = 0;
+    while (position < size) {
+        const size_t next = nextLineStart(data, size, position);
+        size_t end = next;
+        if (end > position && data[end - 1] == '\n') --end;
+        if (end > position && data[end - 1] == '\r') --end;
+        worker.words.emplace_back(data + position, end - position);
+        if (worker.words.size() == kGroupSize) flush();
+        position = next;
+    }
+    if (!worker.words.empty()) flush();
+}
+
+void BatchMatcher::processBlock(const char* data, size_t size, const Options& options, std::vector<Worker>& workers,
+    std::ostream& output, Summary& summary) const {
+    // Bucatile se taie la capete de linie; unele pot ramane goale
+    const size_t parts = workers.size();
+    std::vector<size_t> bounds(parts + 1, size);
+    bounds[0] = 0;
+    for (size_t i = 1; i < parts; ++i) {
+        bounds[i] = std::max(bounds[i - 1], nextLineStart(data, size, size * i / parts));
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < parts; ++i) {
+        if (bounds[i] == bounds[i + 1]) {
+            processLines(data, 0, options.output, workers[i]);
+            continue;
+        }
+        threads.emplace_back([&, i] {
+            processLines(data + bounds[i], bounds[i + 1] - bounds[i], options.output, workers[i]);
+        });
+    }
+    processLines(data, bounds[1], options.output, workers[0]);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (Worker& worker : workers) {
+        output.write(worker.output.data(), static_cast<std::streamsize>(worker.output.size()));
+        summary.words += worker.wordCount;
+        summary.accepted += worker.acceptedCount;
+    }
+    summary.bytes += size;
+}
+
+bool BatchMatcher::runFile(const std::string& path, std::ostream& output, const Options& options,
+    Summary& summary) const {
+    if (path == "-") {
+        runStream(std::cin, output, options, summary);
+        return true;
+    }
+
+    auto mapping = MappedFile::open(path);
+    if (!mapping) {
+        // Fisier gol sau care nu poate fi mapat (de exemplu un pipe): citire obisnuita
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Fisierul nu a putut fi deschis: " << path << "\n";
+            return false;
+        }
+        runStream(file, output, options, summary);
+        return true;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    summary = Summary();
+    std::vector<Worker> workers(resolveThreadCount(options.threadCount));
+    const char* data = reinterpret_cast<const char*>(mapping->data());
+    const size_t size = mapping->size();
+    const size_t step = options.blockSize * workers.size();
+
+    for (size_t position = 0; position < size;) {
+        const size_t end = nextLineStart(data, size, std::min(size, position + step) - 1);
+        processBlock(data + position, end - position, options, workers, output, summary);
+        position = end;
+    }
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+void BatchMatcher::runStream(std::istream& input, std::ostream& output, const Options& options,
+    Summary& summary) const {
+    const auto start = std::chrono::steady_clock::now();
+    summary = Summary();
+    std::vector<Worker> workers(resolveThreadCount(options.threadCount));
+    std::vector<char> buffer(options.blockSize * workers.size());
+    size_t filled = 0; // octeti din buffer, incluzand linia incompleta ramasa de data trecuta
+
+    while (input) {
+        if (filled == buffer.size()) {
+            buffer.resize(buffer.size() * 2); // o linie mai lunga decat bufferul
+        }
+        input.read(buffer.data() + filled, static_cast<std::streamsize>(buffer.size() - filled));
+        filled += static_cast<size_t>(input.gcount());
+
+        // Se proceseaza liniile complete; restul se muta la inceputul bufferului
+        size_t complete = filled;
+        while (complete > 0 && buffer[complete - 1] != '\n') --complete;
+        if (complete == 0) continue;
+        processBlock(buffer.data(), complete, options, workers, output, summary);
+        std::memmove(buffer.data(), buffer.data() + complete, filled - complete);
+        filled -= complete;
+    }
+    if (filled > 0) {
+        processBlock(buffer.data(), filled, options, workers, output, summary);
+    }
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void PrintBatchSummary(const BatchMatcher::Summary& summary) {
+    const double seconds = std::max(summary.seconds, 1e-9);
+    std::cerr << summary.words << " cuvinte (" << summary.accepted << " acceptate), "
+        << summary.bytes << " octeti in " << summary.seconds << " s: "
+        << static_cast<uint64_t>(summary.words / seconds) << " cuvinte/s, "
+        << summary.bytes / seconds / 1e6 << " MB/s\n";
+}
@@ -0,0 +1,65 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CompiledAutomaton.h"
+
+// Verificarea unor liste mari de cuvinte, cate unul pe linie, cu un automat
+// compilat o singura data. Intrarea se citeste in blocuri mari (fisierele sunt
+// mapate in memorie), cuvintele sunt vederi in bloc, fara alocari per cuvant,
+// si trec prin matchesBatch. Rezultatele se scriu intr-un buffer per bloc.
+// Cu mai multe fire, fiecare bloc se imparte la capete de linie intre fire,
+// iar iesirea pastreaza ordinea intrarii.
+// Automatul nu este copiat si trebuie sa traiasca cat obiectul.
+class BatchMatcher {
+public:
+    enum class Output {
+        Flags,    // "1" sau "0" pe linie, in ordinea cuvintelor
+        Accepted, // doar cuvintele acceptate
+        Count     // nimic per cuvant, doar sumarul
+    };
+
+    struct Options {
+        Output output = Output::Flags;
+        unsigned threadCount = 1; // 0 = toate nucleele
+        size_t blockSize = 4 << 20; // octeti de intrare per fir si per bloc
+    };
+
+    struct Summary {
+        uint64_t words = 0;
+        uint64_t accepted = 0;
+        uint64_t bytes = 0;
+        double seconds = 0;
+    };
+
+    explicit BatchMatcher(const CompiledAutomaton& automaton);
+
+    // Fisierul e mapat in memorie; "-" inseamna intrarea standard.
+    // Fals daca fisierul nu poate fi deschis
+    bool runFile(const std::string& path, std::ostream& output, const Options& options, Summary& summary) const;
+    void runStream(std::istream& input, std::ostream& output, const Options& options, Summary& summary) const;
+
+private:
+    // Starea unui fir, refolosita de la un bloc la altul
+    struct Worker {
+        std::string output;
+        std::vector<std::string_view> words;
+        std::vector<uint64_t> results;
+        uint64_t wordCount = 0;
+        uint64_t acceptedCount = 0;
+    };
+
+    // Linii complete; ultima poate sa nu aiba '\n' doar la sfarsitul intrarii
+    void processBlock(const char* data, size_t size, const Options& options, std::vector<Worker>& workers,
+        std::ostream& output, Summary& summary) const;
+    void processLines(const char* data, size_t size, Output mode, Worker& worker) const;
+
+    const CompiledAutomaton& automaton;
+};
+
+// "N cuvinte (M acceptate), B octeti in S s: X cuvinte/s, Y MB/s" la stderr
+void PrintBatchSummary(const BatchMatcher::Summary& summary);
@@ -0,0 +1,40 @@
+﻿#include "ByteClasses.h"
+#include <map>
+
+ByteClasses::ByteClasses()
+    : classCount(kMaxClasses) {
+    for (uint32_t byte = 0; byte < kMaxClasses; ++byte) {
+        map[byte] = static_cast<uint8_t>(byte);
+        representatives[byte] = static_cast<uint8_t>(byte);
+    }
+}
+
+ByteClasses ByteClasses::fromKeys(const std::vector<std::vector<uint32_t>>& keys) {
+    ByteClasses classes;
+    std::map<const std::vector<uint32_t>*, uint8_t, bool(*)(const std::vector<uint32_t>*, const std::vector<uint32_t>*)> ids(
+        [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return *a < *b; });
+
+    classes.classCount = 0;
+    for (uint32_t byte = 0; byte < kMaxClasses; ++byte) {
+        auto [it, inserted] = ids.emplace(&keys[byte], static_cast<uint8_t>(classes.classCount));
+        if (inserted) classes.representatives[classes.classCount++] = static_cast<uint8_t>(byte);
+        classes.map[byte] = it->second;
+    }
+    return classes;
+}
+
+bool ByteClasses::fromMap(const uint8_t* map, uint32_t classCount, ByteClasses& result) {
+    if (classCount == 0 || classCount > kMaxClasses) return false;
+
+    // Fiecare clasa trebuie sa apara, iar reprezentantii sa fie in ordine crescatoare
+    uint32_t seen = 0;
+    for (uint32_t byte = 0; byte < kMaxClasses; ++byte) {
+        if (map[byte] > seen || map[byte] >= classCount) return false;
+        if (map[byte] == seen) result.representatives[seen++] = static_cast<uint8_t>(byte);
+        result.map[byte] = map[byte];
+    }
+    if (seen != classCount) return false;
+
+    result.classCount = classCount;
+    return true;
+}
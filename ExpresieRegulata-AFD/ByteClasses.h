@@ -0,0 +1,38 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+
+// Partitia celor 256 de octeti in clase de echivalenta: doi octeti sunt in
+// aceeasi clasa daca nicio tranzitie a automatului nu ii deosebeste. Tabelele
+// de tranzitii au astfel cate o coloana pe clasa, nu pe octet.
+class ByteClasses {
+public:
+    static constexpr uint32_t kMaxClasses = 256;
+
+    // Identitatea: fiecare octet e singur in clasa lui
+    ByteClasses();
+
+    // Octetii cu chei egale ajung in aceeasi clasa; clasele se numeroteaza in
+    // ordinea primului octet, deci rezultatul nu depinde de ordinea cheilor egale
+    static ByteClasses fromKeys(const std::vector<std::vector<uint32_t>>& keys);
+    // Din harta octet -> clasa (de exemplu citita din fisier); fals daca nu e valida
+    static bool fromMap(const uint8_t* map, uint32_t classCount, ByteClasses& result);
+
+    uint32_t getClassCount() const { return classCount; }
+    uint8_t classOf(unsigned char byte) const { return map[byte]; }
+    // Cel mai mic octet din clasa
+    unsigned char getRepresentative(uint32_t byteClass) const { return representatives[byteClass]; }
+    const uint8_t* data() const { return map; }
+
+    template <typename F>
+    void forEachByte(uint32_t byteClass, F&& f) const {
+        for (unsigned byte = representatives[byteClass]; byte < kMaxClasses; ++byte) {
+            if (map[byte] == byteClass) f(static_cast<unsigned char>(byte));
+        }
+    }
+
+private:
+    uint8_t map[kMaxClasses];
+    uint8_t representatives[kMaxClasses];
+    uint32_t classCount;
+};
@@ -0,0 +1,182 @@
+﻿#include "CodeGenerator.h"
+#include "DeterministicFiniteAutomaton.h"
+#include "LambdaNFA.h"
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace {
+
+std::string byteLiteral(unsigned char byte) {
+    if (std::isalnum(byte)) return std::string("'") + static_cast<char>(byte) + "'";
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "0x%02X", byte);
+    return buffer;
+}
+
+std::string stringLiteral(const std::string& text) {
+    std::string result = "\"";
+    for (unsigned char symbol : text) {
+        if (symbol == '"' || symbol == '\\') {
+            result += '\\';
+            result += static_cast<char>(symbol);
+        }
+        else if (symbol < 0x20 || symbol >= 0x7F) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\x%02X\"\"", symbol); // "" opreste secventa hexa
+            result += buffer;
+        }
+        else {
+            result += static_cast<char>(symbol);
+        }
+    }
+    return result + "\"";
+}
+
+}
+
+void generateMatcherFunction(const DeterministicFiniteAutomaton& dfa, const std::string& functionName, std::ostream& out) {
+    const CompiledAutomaton& compiled = dfa.getCompiled();
+    const ByteClasses& classes = compiled.getByteClasses();
+    constexpr uint32_t kNone = UINT32_MAX;
+
+    out << "inline bool " << functionName << "(std::string_view word) noexcept {\n";
+    if (compiled.getStartState() == CompiledAutomaton::kDeadState) {
+        out << "    (void)word;\n    return false;\n}\n";
+        return;
+    }
+
+    // Starile accesibile, numerotate in ordinea BFS; starea moarta nu are eticheta
+    std::vector<uint32_t> label(compiled.getStateCount(), kNone);
+    std::vector<uint32_t> order = { compiled.getStartState() };
+    std::vector<uint8_t> referenced(1, 0);
+    label[compiled.getStartState()] = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (uint32_t byteClass = 0; byteClass < classes.getClassCount(); ++byteClass) {
+            uint32_t target = compiled.nextByClass(order[i], byteClass);
+            if (target == CompiledAutomaton::kDeadState) continue;
+            if (label[target] == kNone) {
+                label[target] = static_cast<uint32_t>(order.size());
+                order.push_back(target);
+                referenced.push_back(0);
+            }
+            referenced[label[target]] = 1;
+        }
+    }
+
+    out << "    const unsigned char* p = reinterpret_cast<const unsigned char*>(word.data());\n";
+    out << "    const unsigned char* const end = p + word.size();\n";
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        const uint32_t state = order[i];
+        if (referenced[i]) out << "s" << i << ":\n";
+        out << "    if (p == end) return " << (compiled.isAccepting(state) ? "true" : "false") << ";\n";
+
+        // Octetii grupati dupa destinatie (kNone = starea moarta); grupul cel mai
+        // mare devine ramura default
+        std::map<uint32_t, std::vector<unsigned char>> groups;
+        for (unsigned byte = 0; byte < CompiledAutomaton::kAlphabetSize; ++byte) {
+            uint32_t target = compiled.next(state, static_cast<unsigned char>(byte));
+            groups[target == CompiledAutomaton::kDeadState ? kNone : label[target]].push_back(static_cast<unsigned char>(byte));
+        }
+        uint32_t defaultGroup = kNone;
+        size_t defaultSize = 0;
+        for (const auto& [target, bytes] : groups) {
+            if (bytes.size() > defaultSize) {
+                defaultGroup = target;
+                defaultSize = bytes.size();
+            }
+        }
+
+        auto action = [](uint32_t target) {
+            return target == kNone ? std::string("return false;") : "goto s" + std::to_string(target) + ";";
+        };
+        out << "    switch (*p++) {\n";
+        for (const auto& [target, bytes] : groups) {
+            if (target == defaultGroup) continue;
+            for (size_t k = 0; k < bytes.size(); ++k) {
+                out << (k % 8 == 0 ? "    " : " ") << "case " << byteLiteral(bytes[k]) << ":";
+                if (k % 8 == 7 && k + 1 < bytes.size()) out << "\n";
+            }
+            out << " " << action(target) << "\n";
+        }
+        out << "    default: " << action(defaultGroup) << "\n";
+        out << "    }\n";
+    }
+    out << "}\n";
+}
+
+bool generateMatcherHeader(const std::vector<std::string>& expressions, const std::string& namespaceName,
+    std::ostream& out, const DeterminizeLimits& limits) {
+    out << "// Generat de ExpresieRegulata-AFD --generate. Nu se editeaza manual.\n";
+    out << "#pragma once\n#include <cstddef>\n#include <string_view>\n\n";
+    out << "namespace " << namespaceName << " {\n\n";
+
+    for (size_t i = 0; i < expressions.size(); ++i) {
+        LambdaNFA nfa;
+        if (!LambdaNFA::fromExpression(expressions[i], nfa)) {
+            std::cerr << "Eroare: Expresia " << i << " (" << expressions[i] << ") este invalida.\n";
+            return false;
+        }
+        DeterministicFiniteAutomaton dfa;
+        if (!nfa.toDFA(limits, dfa)) {
+            PrintLimitsExceeded("expresia " + std::to_string(i) + " (" + expressions[i] + ")", limits);
+            return false;
+        }
+        out << "// " << expressions[i] << "\n";
+        generateMatcherFunction(dfa.minimize(), "match" + std::to_string(i), out);
+        out << "\n";
+    }
+
+    out << "struct Pattern {\n";
+    out << "    const char* expression;\n";
+    out << "    bool (*match)(std::string_view) noexcept;\n";
+    out << "};\n\n";
+    out << "inline constexpr std::size_t kPatternCount = " << expressions.size() << ";\n";
+    if (!expressions.empty()) {
+        out << "inline constexpr Pattern kPatterns[kPatternCount] = {\n";
+        for (size_t i = 0; i < expressions.size(); ++i) {
+            out << "    { " << stringLiteral(expressions[i]) << ", match" << i << " },\n";
+        }
+        out << "};\n";
+    }
+    out << "\n}\n";
+    return true;
+}
+
+bool generateMatcherHeaderFile(const std::string& patternPath, const std::string& outputPath,
+    const std::string& namespaceName, const DeterminizeLimits& limits) {
+    std::ifstream file(patternPath);
+    if (!file.is_open()) {
+        std::cerr << "Fisierul nu a putut fi deschis: " << patternPath << "\n";
+        return false;
+    }
+
+    std::vector<std::string> expressions;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) expressions.push_back(line);
+    }
+
+    // Fisierul se scrie doar la succes, ca un antet incomplet sa nu para actualizat la urmatoarea compilare
+    std::ostringstream source;
+    if (!generateMatcherHeader(expressions, namespaceName, source, limits)) {
+        return false;
+    }
+
+    std::ofstream output(outputPath, std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << "Eroare: Fisierul " << outputPath << " nu a putut fi creat.\n";
+        return false;
+    }
+    output << source.str();
+    if (!output) {
+        std::cerr << "Eroare: Scrierea in " << outputPath << " a esuat.\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,23 @@
+﻿#pragma once
+#include <ostream>
+#include <string>
+#include <vector>
+#include "LambdaNFA.h"
+
+class DeterministicFiniteAutomaton;
+
+// Scrie o functie C++ independenta (fara tabele si fara aceasta biblioteca)
+// care recunoaste limbajul AFD-ului: cate o eticheta pe stare si un switch pe
+// octetul curent, ca in re2c.
+//   inline bool <functionName>(std::string_view word) noexcept
+void generateMatcherFunction(const DeterministicFiniteAutomaton& dfa, const std::string& functionName, std::ostream& out);
+
+// Antet complet pentru mai multe expresii: functiile match0, match1, ... si
+// tabloul kPatterns cu expresia si functia fiecaruia, in namespace-ul dat.
+// Fals daca o expresie este invalida sau AFD-ul ei depaseste limitele.
+bool generateMatcherHeader(const std::vector<std::string>& expressions, const std::string& namespaceName,
+    std::ostream& out, const DeterminizeLimits& limits = DeterminizeLimits::standard());
+
+// Ca mai sus, cu cate o expresie pe linie in patternPath; rezultatul se scrie in outputPath
+bool generateMatcherHeaderFile(const std::string& patternPath, const std::string& outputPath,
+    const std::string& namespaceName, const DeterminizeLimits& limits = DeterminizeLimits::standard());
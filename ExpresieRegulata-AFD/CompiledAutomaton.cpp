@@ -0,0 +1,414 @@
+﻿#include "CompiledAutomaton.h"
+#include "MappedFile.h"
+#include "PipelineStats.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define COMPILED_AVX2 1
+#endif
+
+namespace {
+
+constexpr char kMagic[8] = { 'A', 'F', 'D', 'B', 'I', 'N', '\0', '\0' };
+constexpr uint32_t kFormatVersion = 3;
+// Versiunea 2 nu avea sectiunea sursei; antetul ei se opreste la sourceOffset
+constexpr uint32_t kFormatVersionWithoutSource = 2;
+constexpr uint32_t kEndianCheck = 0x01020304;
+constexpr uint64_t kSectionAlignment = 64;
+
+// Antetul fisierului; sectiunile sunt aliniate la 64 de octeti fata de inceput
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t endianCheck;
+    uint32_t alphabetSize;
+    uint32_t stateCount;
+    uint32_t startState;
+    uint32_t classCount;
+    uint8_t classMap[256];
+    uint64_t tableOffset;
+    uint64_t tableBytes;
+    uint64_t acceptOffset;
+    uint64_t acceptBytes;
+    uint64_t sourceHash;
+    uint64_t checksum; // peste harta claselor, tabel, bitmap si sursa
+    uint64_t sourceOffset;
+    uint64_t sourceBytes;
+};
+
+uint64_t alignUp(uint64_t value) {
+    return (value + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+}
+
+// offset + bytes <= size, fara depasire la adunare (antetul vine dintr-un fisier oarecare)
+bool sectionFits(uint64_t offset, uint64_t bytes, uint64_t size) {
+    return offset <= size && bytes <= size - offset;
+}
+
+uint64_t contentChecksum(const uint8_t* classMap, const uint32_t* table, uint64_t tableBytes,
+    const uint64_t* acceptBits, uint64_t acceptBytes, const char* source, uint64_t sourceBytes) {
+    uint64_t hash = HashBytes(classMap, CompiledAutomaton::kAlphabetSize);
+    hash = HashBytes(table, tableBytes, hash);
+    hash = HashBytes(acceptBits, acceptBytes, hash);
+    return HashBytes(source, sourceBytes, hash);
+}
+
+}
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+CompiledAutomaton::CompiledAutomaton()
+    : CompiledAutomaton(1, kDeadState) {
+}
+
+CompiledAutomaton::CompiledAutomaton(uint32_t stateCount, uint32_t startState, const ByteClasses& classes)
+    : stateCount(stateCount), startState(startState), classes(classes),
+    ownedTable(static_cast<size_t>(stateCount) * classes.getClassCount(), kDeadState),
+    ownedAcceptBits((stateCount + 63) / 64, 0) {
+    pointToOwned();
+}
+
+CompiledAutomaton::CompiledAutomaton(const CompiledAutomaton& other)
+    : stateCount(other.stateCount), startState(other.startState), classes(other.classes),
+    table(other.table), acceptBits(other.acceptBits),
+    ownedTable(other.ownedTable), ownedAcceptBits(other.ownedAcceptBits), mapping(other.mapping) {
+    if (!mapping) pointToOwned();
+}
+
+CompiledAutomaton& CompiledAutomaton::operator=(const CompiledAutomaton& other) {
+    if (this != &other) {
+        stateCount = other.stateCount;
+        startState = other.startState;
+        classes = other.classes;
+        table = other.table;
+        acceptBits = other.acceptBits;
+        ownedTable = other.ownedTable;
+        ownedAcceptBits = other.ownedAcceptBits;
+        mapping = other.mapping;
+        if (!mapping) pointToOwned();
+    }
+    return *this;
+}
+
+void CompiledAutomaton::pointToOwned() {
+    table = ownedTable.data();
+    acceptBits = ownedAcceptBits.data();
+}
+
+void CompiledAutomaton::setTransition(uint32_t from, unsigned char byte, uint32_t to) {
+    setClassTransition(from, classes.classOf(byte), to);
+}
+
+void CompiledAutomaton::setClassTransition(uint32_t from, uint32_t byteClass, uint32_t to) {
+    ownedTable[static_cast<size_t>(from) * classes.getClassCount() + byteClass] = to;
+}
+
+void CompiledAutomaton::mergeEquivalentClasses() {
+    const uint32_t classCount = classes.getClassCount();
+
+    // Coloanele se compara direct in tabel: o copie per octet ar costa 256 de coloane
+    std::vector<uint64_t> hashes(classCount, 1469598103934665603ull);
+    for (uint32_t state = 0; state < stateCount; ++state) {
+        for (uint32_t byteClass = 0; byteClass < classCount; ++byteClass) {
+            hashes[byteClass] = (hashes[byteClass] ^ ownedTable[static_cast<size_t>(state) * classCount + byteClass])
+                * 1099511628211ull;
+        }
+    }
+    auto sameColumn = [&](uint32_t a, uint32_t b) {
+        for (size_t row = 0; row < ownedTable.size(); row += classCount) {
+            if (ownedTable[row + a] != ownedTable[row + b]) return false;
+        }
+        return true;
+    };
+
+    // Cheia unei clase este prima clasa cu aceeasi coloana
+    std::vector<uint32_t> canonical(classCount);
+    for (uint32_t byteClass = 0; byteClass < classCount; ++byteClass) {
+        canonical[byteClass] = byteClass;
+        for (uint32_t earlier = 0; earlier < byteClass; ++earlier) {
+            if (canonical[earlier] == earlier && hashes[earlier] == hashes[byteClass] && sameColumn(earlier, byteClass)) {
+                canonical[byteClass] = earlier;
+                break;
+            }
+        }
+    }
+    std::vector<std::vector<uint32_t>> keys(kAlphabetSize);
+    for (uint32_t byte = 0; byte < kAlphabetSize; ++byte) {
+        keys[byte].push_back(canonical[classes.classOf(static_cast<unsigned char>(byte))]);
+    }
+
+    ByteClasses merged = ByteClasses::fromKeys(keys);
+    const uint32_t mergedCount = merged.getClassCount();
+    if (mergedCount == classCount) return;
+
+    std::vector<uint32_t> mergedTable(static_cast<size_t>(stateCount) * mergedCount);
+    for (uint32_t byteClass = 0; byteClass < mergedCount; ++byteClass) {
+        const uint32_t source = classes.classOf(merged.getRepresentative(byteClass));
+        for (uint32_t state = 0; state < stateCount; ++state) {
+            mergedTable[static_cast<size_t>(state) * mergedCount + byteClass] =
+                ownedTable[static_cast<size_t>(state) * classCount + source];
+        }
+    }
+
+    classes = merged;
+    ownedTable = std::move(mergedTable);
+    pointToOwned();
+}
+
+void CompiledAutomaton::setAccepting(uint32_t state, bool value) {
+    uint64_t bit = uint64_t(1) << (state & 63);
+    if (value) ownedAcceptBits[state >> 6] |= bit;
+    else ownedAcceptBits[state >> 6] &= ~bit;
+}
+
+bool CompiledAutomaton::matches(std::string_view word) const {
+    REGEX_AFD_STAGE(PipelineStage::Matching);
+    const uint32_t* row = table;
+    const uint8_t* classMap = classes.data();
+    const size_t classCount = classes.getClassCount();
+    uint32_t state = startState;
+
+    for (size_t i = 0; i < word.size(); ++i) {
+        state = row[state * classCount + classMap[static_cast<unsigned char>(word[i])]];
+        if (state == kDeadState) {
+            REGEX_AFD_RECORD(++pipeline.wordsMatched; pipeline.bytesScanned += i + 1; ++pipeline.deadStateExits);
+            return false; // Din starea moarta nu se mai poate accepta
+        }
+    }
+
+    REGEX_AFD_RECORD(++pipeline.wordsMatched; pipeline.bytesScanned += word.size());
+    return isAccepting(state);
+}
+
+void CompiledAutomaton::matchesBatch(const std::string_view* words, size_t count, uint64_t* results) const {
+    REGEX_AFD_STAGE(PipelineStage::Matching);
+    REGEX_AFD_RECORD(pipeline.wordsMatched += count;
+        for (size_t i = 0; i < count; ++i) pipeline.bytesScanned += words[i].size());
+    std::fill(results, results + (count + 63) / 64, 0);
+    if (count == 0) return;
+
+    // Cuvintele se grupeaza dupa lungime (sortare prin numarare), ca benzile
+    // unui grup sa se termine aproape odata si cozile sa fie scurte
+    constexpr size_t kLengthBuckets = 256;
+    std::vector<size_t> bucketStart(kLengthBuckets + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        ++bucketStart[std::min(words[i].size(), kLengthBuckets - 1) + 1];
+    }
+    for (size_t bucket = 0; bucket < kLengthBuckets; ++bucket) {
+        bucketStart[bucket + 1] += bucketStart[bucket];
+    }
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[bucketStart[std::min(words[i].size(), kLengthBuckets - 1)]++] = i;
+    }
+
+    const uint8_t* classMap = classes.data();
+    const size_t classCount = classes.getClassCount();
+#ifdef COMPILED_AVX2
+    // Indicii din gather sunt pe 32 de biti cu semn
+    const bool useGather = static_cast<uint64_t>(stateCount) * classCount <= INT32_MAX;
+    const __m256i classCountVector = _mm256_set1_epi32(static_cast<int32_t>(classCount));
+#endif
+    static_assert(kDeadState == 0, "testul de terminare presupune starea moarta 0");
+    static_assert(kBatchLanes == 8, "bucla de mai jos are benzile scrise explicit");
+
+    for (size_t base = 0; base < count; base += kBatchLanes) {
+        const size_t lanes = std::min(kBatchLanes, count - base);
+        const unsigned char* data[kBatchLanes];
+        size_t length[kBatchLanes];
+        uint32_t state[kBatchLanes];
+        size_t common = SIZE_MAX;
+        for (size_t k = 0; k < kBatchLanes; ++k) {
+            // Benzile nefolosite din ultimul grup repeta primul cuvant
+            const std::string_view word = words[order[base + (k < lanes ? k : 0)]];
+            data[k] = reinterpret_cast<const unsigned char*>(word.data());
+            length[k] = word.size();
+            state[k] = startState;
+            common = std::min(common, length[k]);
+        }
+
+        // Prefixul comun: toate benzile avanseaza impreuna, fara verificari de lungime
+        size_t i = 0;
+        while (i < common) {
+            const size_t stop = std::min(common, i + 8);
+#ifdef COMPILED_AVX2
+            if (useGather) {
+                __m256i states = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state));
+                alignas(32) int32_t byteClasses[kBatchLanes];
+                for (; i < stop; ++i) {
+                    for (size_t k = 0; k < kBatchLanes; ++k) byteClasses[k] = classMap[data[k][i]];
+                    const __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(states, classCountVector),
+                        _mm256_load_si256(reinterpret_cast<const __m256i*>(byteClasses)));
+                    states = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table), index, 4);
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(state), states);
+            }
+            else
+#endif
+            {
+                // Starile in variabile locale: prin tabloul state compilatorul ar trebui sa
+                // le reciteasca dupa fiecare citire de octet (char poate face alias)
+                uint32_t s0 = state[0], s1 = state[1], s2 = state[2], s3 = state[3];
+                uint32_t s4 = state[4], s5 = state[5], s6 = state[6], s7 = state[7];
+                for (; i < stop; ++i) {
+                    s0 = table[s0 * classCount + classMap[data[0][i]]];
+                    s1 = table[s1 * classCount + classMap[data[1][i]]];
+                    s2 = table[s2 * classCount + classMap[data[2][i]]];
+                    s3 = table[s3 * classCount + classMap[data[3][i]]];
+                    s4 = table[s4 * classCount + classMap[data[4][i]]];
+                    s5 = table[s5 * classCount + classMap[data[5][i]]];
+                    s6 = table[s6 * classCount + classMap[data[6][i]]];
+                    s7 = table[s7 * classCount + classMap[data[7][i]]];
+                }
+                state[0] = s0; state[1] = s1; state[2] = s2; state[3] = s3;
+                state[4] = s4; state[5] = s5; state[6] = s6; state[7] = s7;
+            }
+
+            // Starea moarta este 0: daca toate benzile au murit, grupul s-a terminat
+            uint32_t alive = 0;
+            for (size_t k = 0; k < kBatchLanes; ++k) alive |= state[k];
+            if (alive == kDeadState) break;
+        }
+
+        // Cozile ramase dupa prefixul comun, cate o banda
+        for (size_t k = 0; k < lanes; ++k) {
+            uint32_t current = state[k];
+            for (size_t j = i; j < length[k] && current != kDeadState; ++j) {
+                current = table[current * classCount + classMap[data[k][j]]];
+            }
+            const size_t index = order[base + k];
+            results[index >> 6] |= static_cast<uint64_t>(isAccepting(current)) << (index & 63);
+        }
+    }
+}
+
+bool CompiledAutomaton::saveToFile(const std::string& path, uint64_t sourceHash, std::string_view source) const {
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.headerSize = sizeof(FileHeader);
+    header.endianCheck = kEndianCheck;
+    header.alphabetSize = kAlphabetSize;
+    header.stateCount = stateCount;
+    header.startState = startState;
+    header.classCount = classes.getClassCount();
+    std::memcpy(header.classMap, classes.data(), kAlphabetSize);
+    header.tableBytes = static_cast<uint64_t>(stateCount) * header.classCount * sizeof(uint32_t);
+    header.acceptBytes = (stateCount + 63) / 64 * sizeof(uint64_t);
+    header.tableOffset = alignUp(sizeof(FileHeader));
+    header.acceptOffset = alignUp(header.tableOffset + header.tableBytes);
+    header.sourceOffset = header.acceptOffset + header.acceptBytes;
+    header.sourceBytes = source.size();
+    header.sourceHash = sourceHash;
+    header.checksum = contentChecksum(header.classMap, table, header.tableBytes, acceptBits, header.acceptBytes,
+        source.data(), header.sourceBytes);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Eroare: Fisierul " << path << " nu a putut fi creat.\n";
+        return false;
+    }
+
+    const char padding[kSectionAlignment] = {};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(padding, header.tableOffset - sizeof(header));
+    file.write(reinterpret_cast<const char*>(table), header.tableBytes);
+    file.write(padding, header.acceptOffset - (header.tableOffset + header.tableBytes));
+    file.write(reinterpret_cast<const char*>(acceptBits), header.acceptBytes);
+    file.write(source.data(), header.sourceBytes);
+
+    if (!file) {
+        std::cerr << "Eroare: Scrierea in " << path << " a esuat.\n";
+        return false;
+    }
+    return true;
+}
+
+bool CompiledAutomaton::loadFromFile(const std::string& path, CompiledAutomaton& result,
+    bool verify, uint64_t* sourceHash, std::string* source) {
+    std::shared_ptr<const MappedFile> file = MappedFile::open(path);
+    if (!file) {
+        std::cerr << "Eroare: Fisierul " << path << " nu a putut fi mapat.\n";
+        return false;
+    }
+
+    if (file->size() < sizeof(FileHeader)) {
+        std::cerr << "Eroare: " << path << " este prea mic pentru un automat compilat.\n";
+        return false;
+    }
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(file->data());
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->endianCheck != kEndianCheck) {
+        std::cerr << "Eroare: " << path << " nu este un automat compilat pentru aceasta platforma.\n";
+        return false;
+    }
+    const bool hasSource = header->version == kFormatVersion && header->headerSize == sizeof(FileHeader);
+    const bool withoutSource = header->version == kFormatVersionWithoutSource
+        && header->headerSize == offsetof(FileHeader, sourceOffset);
+    if (!(hasSource || withoutSource) || header->alphabetSize != kAlphabetSize) {
+        std::cerr << "Eroare: Versiune necunoscuta a formatului in " << path << ".\n";
+        return false;
+    }
+
+    ByteClasses classes;
+    if (!ByteClasses::fromMap(header->classMap, header->classCount, classes)) {
+        std::cerr << "Eroare: Harta claselor de octeti este invalida in " << path << ".\n";
+        return false;
+    }
+
+    uint64_t expectedTable = static_cast<uint64_t>(header->stateCount) * header->classCount * sizeof(uint32_t);
+    uint64_t expectedAccept = (header->stateCount + 63) / 64 * sizeof(uint64_t);
+    const uint64_t sourceOffset = hasSource ? header->sourceOffset : 0;
+    const uint64_t sourceBytes = hasSource ? header->sourceBytes : 0;
+    if (header->stateCount == 0 || header->startState >= header->stateCount
+        || header->tableBytes != expectedTable || header->acceptBytes != expectedAccept
+        || header->tableOffset % kSectionAlignment != 0 || header->acceptOffset % kSectionAlignment != 0
+        || !sectionFits(header->tableOffset, header->tableBytes, file->size())
+        || !sectionFits(header->acceptOffset, header->acceptBytes, file->size())
+        || !sectionFits(sourceOffset, sourceBytes, file->size())) {
+        std::cerr << "Eroare: Antet invalid in " << path << ".\n";
+        return false;
+    }
+
+    const uint32_t* table = reinterpret_cast<const uint32_t*>(file->data() + header->tableOffset);
+    const uint64_t* acceptBits = reinterpret_cast<const uint64_t*>(file->data() + header->acceptOffset);
+    const char* sourceText = reinterpret_cast<const char*>(file->data() + sourceOffset);
+    if (verify) {
+        if (contentChecksum(header->classMap, table, header->tableBytes, acceptBits, header->acceptBytes,
+                sourceText, sourceBytes) != header->checksum) {
+            std::cerr << "Eroare: Suma de control nu corespunde in " << path << ".\n";
+            return false;
+        }
+        for (uint64_t i = 0; i < expectedTable / sizeof(uint32_t); ++i) {
+            if (table[i] >= header->stateCount) {
+                std::cerr << "Eroare: Tranzitie spre o stare inexistenta in " << path << ".\n";
+                return false;
+            }
+        }
+    }
+
+    result.stateCount = header->stateCount;
+    result.startState = header->startState;
+    result.classes = classes;
+    result.table = table;
+    result.acceptBits = acceptBits;
+    result.ownedTable.clear();
+    result.ownedAcceptBits.clear();
+    result.mapping = std::move(file);
+    if (sourceHash) *sourceHash = header->sourceHash;
+    if (source) source->assign(sourceText, sourceBytes);
+    return true;
+}
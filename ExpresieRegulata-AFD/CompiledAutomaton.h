@@ -0,0 +1,82 @@
+﻿#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ByteClasses.h"
+
+class MappedFile;
+
+// Forma compilata a unui AFD: stari numerotate dens, tabel de tranzitii
+// contiguu [stare][clasa de octeti], harta octet -> clasa si un bitmap de acceptare.
+// Starea 0 este starea moarta (toate tranzitiile ei duc tot in 0).
+//
+// Tabelul poate fi detinut de obiect sau poate fi o vedere direct peste un
+// fisier mapat (loadFromFile), fara copiere si fara parsare.
+class CompiledAutomaton {
+public:
+    static constexpr uint32_t kDeadState = 0;
+    static constexpr uint32_t kAlphabetSize = 256;
+
+    CompiledAutomaton();
+    CompiledAutomaton(uint32_t stateCount, uint32_t startState, const ByteClasses& classes = ByteClasses());
+    CompiledAutomaton(const CompiledAutomaton& other);
+    CompiledAutomaton& operator=(const CompiledAutomaton& other);
+    CompiledAutomaton(CompiledAutomaton&& other) = default;
+    CompiledAutomaton& operator=(CompiledAutomaton&& other) = default;
+
+    uint32_t getStateCount() const { return stateCount; }
+    uint32_t getStartState() const { return startState; }
+    const ByteClasses& getByteClasses() const { return classes; }
+    uint32_t getClassCount() const { return classes.getClassCount(); }
+
+    uint32_t next(uint32_t state, unsigned char byte) const {
+        return table[static_cast<size_t>(state) * classes.getClassCount() + classes.classOf(byte)];
+    }
+    uint32_t nextByClass(uint32_t state, uint32_t byteClass) const {
+        return table[static_cast<size_t>(state) * classes.getClassCount() + byteClass];
+    }
+    bool isAccepting(uint32_t state) const { return (acceptBits[state >> 6] >> (state & 63)) & 1; }
+
+    // Doar pentru tabele detinute (nu pentru cele incarcate din fisier).
+    // setTransition modifica toata clasa octetului.
+    void setTransition(uint32_t from, unsigned char byte, uint32_t to);
+    void setClassTransition(uint32_t from, uint32_t byteClass, uint32_t to);
+    void setAccepting(uint32_t state, bool value);
+    // Uneste clasele ale caror coloane sunt identice; apelat dupa completarea tabelului
+    void mergeEquivalentClasses();
+
+    // Ruleaza cuvantul pe tabel; fara alocari si fara mesaje
+    bool matches(std::string_view word) const;
+    // Acelasi rezultat pentru count cuvinte: bitul i din results (count/64 rotunjit
+    // in sus cuvinte de 64 de biti) este 1 daca words[i] e acceptat. Cuvintele avanseaza
+    // cate kBatchLanes deodata, ca latentele citirilor din tabel sa se suprapuna.
+    static constexpr size_t kBatchLanes = 8;
+    void matchesBatch(const std::string_view* words, size_t count, uint64_t* results) const;
+
+    // Format binar: antet (cu harta claselor), tabel dens, bitmap de acceptare si,
+    // optional, textul sursei; sourceHash identifica sursa
+    bool saveToFile(const std::string& path, uint64_t sourceHash = 0, std::string_view source = {}) const;
+    // Cu verify = false se verifica doar antetul, iar tabelul nu este citit deloc
+    // (fisierul trebuie sa fie de incredere: tranzitiile nu mai sunt validate).
+    // Fisierele din versiunea 2 a formatului nu au sursa: `source` iese gol.
+    static bool loadFromFile(const std::string& path, CompiledAutomaton& result,
+        bool verify = true, uint64_t* sourceHash = nullptr, std::string* source = nullptr);
+
+private:
+    void pointToOwned();
+
+    uint32_t stateCount;
+    uint32_t startState;
+    ByteClasses classes;
+    const uint32_t* table;
+    const uint64_t* acceptBits;
+
+    std::vector<uint32_t> ownedTable;
+    std::vector<uint64_t> ownedAcceptBits;
+    std::shared_ptr<const MappedFile> mapping;
+};
+
+// FNV-1a pe 64 de biti, folosit pentru suma de control si pentru identificarea surselor
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 1469598103934665603ull);
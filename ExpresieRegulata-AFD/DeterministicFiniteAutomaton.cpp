@@ -1,12 +1,82 @@
-﻿#pragma once
-#include "DeterministicFiniteAutomaton.h"
+﻿#include "DeterministicFiniteAutomaton.h"
+#include "AutomatonEquivalence.h"
+#include "LambdaNFA.h"
+#include "PipelineStats.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+// Numarul de tranzitii pe octeti (nu pe clase) care nu duc in starea moarta
+size_t countByteTransitions(const CompiledAutomaton& automaton) {
+    const ByteClasses& classes = automaton.getByteClasses();
+    std::vector<size_t> classSizes(classes.getClassCount(), 0);
+    for (unsigned byte = 0; byte < CompiledAutomaton::kAlphabetSize; ++byte) {
+        ++classSizes[classes.classOf(static_cast<unsigned char>(byte))];
+    }
+    size_t count = 0;
+    for (uint32_t state = 1; state < automaton.getStateCount(); ++state) {
+        for (uint32_t a = 0; a < classes.getClassCount(); ++a) {
+            if (automaton.nextByClass(state, a) != CompiledAutomaton::kDeadState) count += classSizes[a];
+        }
+    }
+    return count;
+}
+
+}
+
+DeterministicFiniteAutomaton::DeterministicFiniteAutomaton()
+    : named(std::make_shared<NamedForm>()) {
 
-DeterministicFiniteAutomaton::DeterministicFiniteAutomaton() {
+}
+
+DeterministicFiniteAutomaton::DeterministicFiniteAutomaton(CompiledAutomaton automaton, const std::set<char>& A,
+    std::string prefix)
+    : alphabet(A), compiled(std::move(automaton)), statePrefix(std::move(prefix)) {
+}
+
+const DeterministicFiniteAutomaton::NamedForm& DeterministicFiniteAutomaton::getNamed() const {
+    std::shared_ptr<const NamedForm> current = std::atomic_load(&named);
+    if (current) {
+        return *current;
+    }
+
+    auto form = std::make_shared<NamedForm>();
+    auto nameOf = [&](uint32_t state) { return statePrefix + std::to_string(state - 1); };
+    const ByteClasses& classes = compiled.getByteClasses();
+    if (compiled.getStartState() == CompiledAutomaton::kDeadState) {
+        // Limbaj vid: o singura stare, nefinala
+        form->initialState = statePrefix + "0";
+        form->states.insert(form->initialState);
+    }
+    else {
+        form->initialState = nameOf(compiled.getStartState());
+        for (uint32_t state = 1; state < compiled.getStateCount(); ++state) {
+            const std::string name = nameOf(state);
+            form->states.insert(name);
+            if (compiled.isAccepting(state)) form->finalStates.insert(name);
+            for (uint32_t a = 0; a < classes.getClassCount(); ++a) {
+                const uint32_t target = compiled.nextByClass(state, a);
+                if (target == CompiledAutomaton::kDeadState) continue;
+                const std::string targetName = nameOf(target);
+                classes.forEachByte(a, [&](unsigned char byte) {
+                    form->transitions.emplace(std::make_pair(name, static_cast<char>(byte)), targetName);
+                });
+            }
+        }
+    }
 
+    // Doua fire pot genera forma deodata; ramane prima publicata, care nu mai e inlocuita
+    std::shared_ptr<const NamedForm> expected;
+    std::shared_ptr<const NamedForm> desired = form;
+    if (std::atomic_compare_exchange_strong(&named, &expected, desired)) {
+        return *form;
+    }
+    return *expected;
 }
 
 const std::set<std::string>& DeterministicFiniteAutomaton::getStates() const {
-    return states;
+    return getNamed().states;
 }
 
 const std::set<char>& DeterministicFiniteAutomaton::getAlphabet() const {
@@ -14,25 +84,83 @@ const std::set<char>& DeterministicFiniteAutomaton::getAlphabet() const {
 }
 
 const std::map<std::pair<std::string, char>, std::string>& DeterministicFiniteAutomaton::getTransitions() const {
-    return transitions;
+    return getNamed().transitions;
 }
 
 const std::string& DeterministicFiniteAutomaton::getInitialState() const {
-    return initialState;
+    return getNamed().initialState;
 }
 
 const std::set<std::string>& DeterministicFiniteAutomaton::getFinalStates() const {
-    return finalStates;
+    return getNamed().finalStates;
+}
+
+size_t DeterministicFiniteAutomaton::getStateCount() const {
+    return compiled.getStateCount() - 1;
+}
+
+const CompiledAutomaton& DeterministicFiniteAutomaton::getCompiled() const {
+    return compiled;
+}
+
+void DeterministicFiniteAutomaton::setSubsetOrigin(std::shared_ptr<const SubsetOrigin> origin) {
+    subsetOrigin = std::move(origin);
 }
 
 
 DeterministicFiniteAutomaton::DeterministicFiniteAutomaton(const std::set<std::string>& Q, const std::set<char>& A,
     const std::map<std::pair<std::string, char>, std::string>& T,
     const std::string& q0, const std::set<std::string>& F)
-    : states(Q), alphabet(A), transitions(T), initialState(q0), finalStates(F) {
+    : alphabet(A), named(std::make_shared<NamedForm>(NamedForm{ Q, T, q0, F })) {
+    compile();
+}
+
+void DeterministicFiniteAutomaton::compile() {
+    const auto& [states, transitions, initialState, finalStates] = *named;
+    // Numerotare densa: 0 e starea moarta, starile reale incep de la 1
+    std::map<std::string, uint32_t> stateIds;
+    uint32_t nextId = 1;
+    for (const auto& state : states) {
+        stateIds[state] = nextId++;
+    }
+
+    auto initialIt = stateIds.find(initialState);
+    uint32_t start = initialIt != stateIds.end() ? initialIt->second : CompiledAutomaton::kDeadState;
+
+    // Doar simbolurile din alfabet primesc tranzitii; restul raman spre starea moarta.
+    // Cheia unui octet este lista perechilor (sursa, destinatie) pe acel octet, deci
+    // octetii cu aceeasi cheie impart o coloana in tabel.
+    std::vector<std::vector<uint32_t>> keys(CompiledAutomaton::kAlphabetSize);
+    for (const auto& [key, value] : transitions) {
+        const auto& [state, symbol] = key;
+        auto fromIt = stateIds.find(state);
+        auto toIt = stateIds.find(value);
+        if (fromIt == stateIds.end() || toIt == stateIds.end() || alphabet.find(symbol) == alphabet.end()) {
+            continue;
+        }
+        std::vector<uint32_t>& column = keys[static_cast<unsigned char>(symbol)];
+        column.push_back(fromIt->second);
+        column.push_back(toIt->second);
+    }
+
+    compiled = CompiledAutomaton(nextId, start, ByteClasses::fromKeys(keys));
+    for (uint32_t byte = 0; byte < CompiledAutomaton::kAlphabetSize; ++byte) {
+        const std::vector<uint32_t>& column = keys[byte];
+        for (size_t i = 0; i < column.size(); i += 2) {
+            compiled.setTransition(column[i], static_cast<unsigned char>(byte), column[i + 1]);
+        }
+    }
+
+    for (const auto& finalState : finalStates) {
+        auto it = stateIds.find(finalState);
+        if (it != stateIds.end()) {
+            compiled.setAccepting(it->second, true);
+        }
+    }
 }
 
 bool DeterministicFiniteAutomaton::VerifyAutomaton() const {
+    const auto& [states, transitions, initialState, finalStates] = getNamed();
     // Verifica daca starea initiala e valida
     if (states.find(initialState) == states.end()) {
         std::cerr << "Eroare: Starea initiala nu este in multimea starilor.\n";
@@ -64,6 +192,7 @@ bool DeterministicFiniteAutomaton::VerifyAutomaton() const {
 }
 
 void DeterministicFiniteAutomaton::PrintAutomaton() const {
+    const auto& [states, transitions, initialState, finalStates] = getNamed();
     std::cout << "Multimea starilor (Q): { ";
     for (const auto& state : states) {
         std::cout << state << " ";
@@ -88,227 +217,282 @@ void DeterministicFiniteAutomaton::PrintAutomaton() const {
         std::cout << finalState << " ";
     }
     std::cout << "}\n";
-}
 
-bool DeterministicFiniteAutomaton::CheckWord(const std::string& word) const {
-    std::string currentState = initialState;
-
-    for (char symbol : word) {
-        if (alphabet.find(symbol) == alphabet.end()) {
-            std::cerr << "Eroare: Simbolul '" << symbol << "' nu este in alfabet.\n";
-            return false;
+    if (subsetOrigin) {
+        std::cout << "Starile AFN corespunzatoare:\n";
+        for (size_t id = 0; id < subsetOrigin->subsets.size(); ++id) {
+            std::set<std::string> stateSet;
+            subsetOrigin->subsets[id].forEach([&](uint32_t nfaState) {
+                stateSet.insert(subsetOrigin->nfaStateNames[nfaState]);
+            });
+            std::cout << "  S" << id << " = " << generateStateName(stateSet) << "\n";
         }
-
-        auto it = transitions.find({ currentState, symbol });
-        if (it == transitions.end()) {
-            std::cerr << "Eroare: Nu exista tranzitie pentru starea " << currentState
-                << " cu simbolul '" << symbol << "'.\n";
-            return false;
-        }
-
-        currentState = it->second; // Trece in starea urmatoare
     }
-
-    // Verificam daca suntem intr-o stare finala
-    return finalStates.find(currentState) != finalStates.end();
 }
 
-// Functie care construieste AFN cu λ-tranzitii din forma poloneza
-DeterministicFiniteAutomaton buildLambdaNFA(const std::string& polishExpression) {
-    std::stack<DeterministicFiniteAutomaton> automataStack;
-    int stateCounter = 0;
-
-    for (char symbol : polishExpression) {
-        if (std::isalpha(symbol)) { // Simbol este caracter
-            std::set<std::string> states = { "q" + std::to_string(stateCounter), "q" + std::to_string(stateCounter + 1) };
-            std::set<char> alphabet = { symbol };
-            std::map<std::pair<std::string, char>, std::string> transitions = {
-                { {"q" + std::to_string(stateCounter), symbol}, "q" + std::to_string(stateCounter + 1) }
-            };
-            DeterministicFiniteAutomaton automaton(states, alphabet, transitions, "q" + std::to_string(stateCounter), { "q" + std::to_string(stateCounter + 1) });
-            automataStack.push(automaton);
-            stateCounter += 2;
-        }
-        else if (symbol == '|') { // Alternare (sau logic)
-            if (automataStack.size() < 2) {
-                std::cerr << "Eroare: prea putine automate pentru operatorul '|'.\n";
-                return DeterministicFiniteAutomaton({}, {}, {}, "", {});
-            }
+bool DeterministicFiniteAutomaton::CheckWord(const std::string& word) const {
+    return compiled.matches(word);
+}
 
-            // Scoatem cele doua automate din stiva
-            DeterministicFiniteAutomaton automaton2 = automataStack.top(); automataStack.pop();
-            DeterministicFiniteAutomaton automaton1 = automataStack.top(); automataStack.pop();
+std::vector<uint64_t> DeterministicFiniteAutomaton::CheckWords(const std::vector<std::string_view>& words) const {
+    std::vector<uint64_t> results((words.size() + 63) / 64, 0);
+    compiled.matchesBatch(words.data(), words.size(), results.data());
+    return results;
+}
 
-            // Cream noi stari initială si finala
-            std::string newInitial = "q" + std::to_string(stateCounter++);
-            std::string newFinal = "q" + std::to_string(stateCounter++);
+DeterministicFiniteAutomaton DeterministicFiniteAutomaton::convertToDFA(unsigned threadCount) const {
+    return LambdaNFA::fromAutomaton(*this).toDFA(threadCount);
+}
 
-            // Construim noul automat
-            std::set<std::string> states = automaton1.getStates();
-            states.insert(automaton2.getStates().begin(), automaton2.getStates().end());
-            states.insert(newInitial);
-            states.insert(newFinal);
+LazyDFA DeterministicFiniteAutomaton::convertToLazyDFA(const LazyDFA::Options& options) const {
+    return LazyDFA(LambdaNFA::fromAutomaton(*this), options);
+}
 
-            std::map<std::pair<std::string, char>, std::string> transitions = automaton1.getTransitions();
-            transitions.insert(automaton2.getTransitions().begin(), automaton2.getTransitions().end());
+DeterministicFiniteAutomaton DeterministicFiniteAutomaton::minimize(MinimizationStats* stats) const {
+    DeterministicFiniteAutomaton result(MinimizeAutomaton(compiled), alphabet, "q");
+    if (stats) {
+        stats->statesBefore = getStateCount();
+        stats->transitionsBefore = countByteTransitions(compiled);
+        stats->statesAfter = result.getStateCount();
+        stats->transitionsAfter = countByteTransitions(result.compiled);
+    }
+    return result;
+}
 
-            transitions[{newInitial, '\0'}] = automaton1.getInitialState();
-            transitions[{newInitial, '\0'}] = automaton2.getInitialState();
-            for (const auto& finalState : automaton1.getFinalStates()) {
-                transitions[{finalState, '\0'}] = newFinal;
-            }
-            for (const auto& finalState : automaton2.getFinalStates()) {
-                transitions[{finalState, '\0'}] = newFinal;
+CompiledAutomaton MinimizeAutomaton(const CompiledAutomaton& compiled) {
+    REGEX_AFD_STAGE(PipelineStage::Minimization);
+    const uint32_t stateCount = compiled.getStateCount(); // include starea moarta 0
+    const uint32_t start = compiled.getStartState();
+    // Hopcroft lucreaza pe clasele de octeti ale tabelului compilat, nu pe alfabet
+    const ByteClasses& classes = compiled.getByteClasses();
+    const size_t symbolCount = classes.getClassCount();
+
+    // Starile accesibile din starea initiala
+    std::vector<uint8_t> reachable(stateCount, 0);
+    std::vector<uint32_t> pending;
+    if (start != CompiledAutomaton::kDeadState) {
+        reachable[start] = 1;
+        pending.push_back(start);
+    }
+    while (!pending.empty()) {
+        uint32_t state = pending.back();
+        pending.pop_back();
+        for (uint32_t a = 0; a < symbolCount; ++a) {
+            uint32_t target = compiled.nextByClass(state, a);
+            if (target != CompiledAutomaton::kDeadState && !reachable[target]) {
+                reachable[target] = 1;
+                pending.push_back(target);
             }
-
-            DeterministicFiniteAutomaton newAutomaton(states, automaton1.getAlphabet(), transitions, newInitial, { newFinal });
-            automataStack.push(newAutomaton);
         }
-        else if (symbol == '.') { // Concatenare
-            if (automataStack.size() < 2) {
-                std::cerr << "Eroare: prea putine automate pentru operatorul '.'.\n";
-                return DeterministicFiniteAutomaton({}, {}, {}, "", {});
-            }
-
-            // Scoatem cele doua automate din stiva
-            DeterministicFiniteAutomaton automaton2 = automataStack.top(); automataStack.pop();
-            DeterministicFiniteAutomaton automaton1 = automataStack.top(); automataStack.pop();
-
-            std::set<std::string> states = automaton1.getStates();
-            states.insert(automaton2.getStates().begin(), automaton2.getStates().end());
-
-            std::map<std::pair<std::string, char>, std::string> transitions = automaton1.getTransitions();
-            transitions.insert(automaton2.getTransitions().begin(), automaton2.getTransitions().end());
+    }
 
-            for (const auto& finalState : automaton1.getFinalStates()) {
-                transitions[{finalState, '\0'}] = automaton2.getInitialState();
+    // Dintre ele, cele din care se mai poate ajunge intr-o stare finala
+    std::vector<std::vector<uint32_t>> predecessors(stateCount);
+    std::vector<uint8_t> useful(stateCount, 0);
+    for (uint32_t state = 1; state < stateCount; ++state) {
+        if (!reachable[state]) continue;
+        for (uint32_t a = 0; a < symbolCount; ++a) {
+            uint32_t target = compiled.nextByClass(state, a);
+            if (target != CompiledAutomaton::kDeadState) {
+                predecessors[target].push_back(state);
             }
-
-            DeterministicFiniteAutomaton newAutomaton(states, automaton1.getAlphabet(), transitions, automaton1.getInitialState(), automaton2.getFinalStates());
-            automataStack.push(newAutomaton);
         }
-        else if (symbol == '*') { // Stelare (Kleene Star)
-            if (automataStack.empty()) {
-                std::cerr << "Eroare: niciun automat pentru operatorul '*'.\n";
-                return DeterministicFiniteAutomaton({}, {}, {}, "", {});
-            }
-
-            // Scoatem automatul din stiva
-            DeterministicFiniteAutomaton automaton = automataStack.top(); automataStack.pop();
-
-            std::string newInitial = "q" + std::to_string(stateCounter++);
-            std::string newFinal = "q" + std::to_string(stateCounter++);
-
-            std::set<std::string> states = automaton.getStates();
-            states.insert(newInitial);
-            states.insert(newFinal);
-
-            std::map<std::pair<std::string, char>, std::string> transitions = automaton.getTransitions();
-
-            transitions[{newInitial, '\0'}] = automaton.getInitialState();
-            transitions[{newInitial, '\0'}] = newFinal;
-            for (const auto& finalState : automaton.getFinalStates()) {
-                transitions[{finalState, '\0'}] = automaton.getInitialState();
-                transitions[{finalState, '\0'}] = newFinal;
+        if (compiled.isAccepting(state)) {
+            useful[state] = 1;
+            pending.push_back(state);
+        }
+    }
+    while (!pending.empty()) {
+        uint32_t state = pending.back();
+        pending.pop_back();
+        for (uint32_t source : predecessors[state]) {
+            if (!useful[source]) {
+                useful[source] = 1;
+                pending.push_back(source);
             }
-
-            DeterministicFiniteAutomaton newAutomaton(states, automaton.getAlphabet(), transitions, newInitial, { newFinal });
-            automataStack.push(newAutomaton);
         }
     }
 
-    if (automataStack.empty()) {
-        std::cerr << "Eroare: stiva este goala la sfarait.\n";
-        return DeterministicFiniteAutomaton({}, {}, {}, "", {});
+    // Renumerotare locala; 0 ramane starea capcana care completeaza tranzitiile
+    std::vector<uint32_t> local(stateCount, 0);
+    std::vector<uint8_t> accepting(1, 0);
+    uint32_t n = 1;
+    for (uint32_t state = 1; state < stateCount; ++state) {
+        if (useful[state]) {
+            local[state] = n++;
+            accepting.push_back(compiled.isAccepting(state) ? 1 : 0);
+        }
+    }
+    std::vector<uint32_t> delta(static_cast<size_t>(n) * symbolCount, 0);
+    for (uint32_t state = 1; state < stateCount; ++state) {
+        if (!useful[state]) continue;
+        for (size_t a = 0; a < symbolCount; ++a) {
+            delta[local[state] * symbolCount + a] = local[compiled.nextByClass(state, static_cast<uint32_t>(a))];
+        }
     }
 
-    return automataStack.top(); // Automat complet construit
-}
-
-DeterministicFiniteAutomaton DeterministicFiniteAutomaton::convertToDFA() const {
-    // Noul set de stări, alfabetul si starea initială
-    std::set<std::string> newStates;
-    std::set<char> newAlphabet = alphabet;
-    std::map<std::pair<std::string, char>, std::string> newTransitions;
-    std::string newInitialState;
-    std::set<std::string> newFinalStates;
-
-    // Mapare intre multimile de stari si noile stari ale AFD
-    std::map<std::set<std::string>, std::string> stateMapping;
-    std::queue<std::set<std::string>> stateQueue;
-
-    // Calculeaza inchiderea lambda pentru toate starile
-    std::map<std::string, std::set<std::string>> lambdaClosure;
-    for (const auto& state : states) {
-        lambdaClosure[state] = calculateLambdaClosure(state);
+    // Tranzitiile inverse, grupate pe (simbol, stare tinta)
+    std::vector<uint32_t> inverseStart(symbolCount * n + 1, 0);
+    std::vector<uint32_t> inverse(static_cast<size_t>(n) * symbolCount);
+    for (uint32_t q = 0; q < n; ++q) {
+        for (size_t a = 0; a < symbolCount; ++a) {
+            ++inverseStart[a * n + delta[q * symbolCount + a] + 1];
+        }
+    }
+    for (size_t i = 1; i < inverseStart.size(); ++i) {
+        inverseStart[i] += inverseStart[i - 1];
+    }
+    std::vector<uint32_t> fill(inverseStart.begin(), inverseStart.end() - 1);
+    for (uint32_t q = 0; q < n; ++q) {
+        for (size_t a = 0; a < symbolCount; ++a) {
+            inverse[fill[a * n + delta[q * symbolCount + a]]++] = q;
+        }
     }
 
-    // Creaza noua stare initială ca inchiderea lambda a starii initiale
-    std::set<std::string> initialClosure = lambdaClosure[initialState];
-    newInitialState = generateStateName(initialClosure);
-    newStates.insert(newInitialState);
-    stateMapping[initialClosure] = newInitialState;
-    stateQueue.push(initialClosure);
+    // Partitia initiala {nefinale, finale}; fiecare bloc e un interval din `elements`
+    std::vector<uint32_t> elements, position(n), blockOf(n);
+    std::vector<uint32_t> blockBegin, blockEnd, marked;
+    for (uint32_t q = 0; q < n; ++q) {
+        if (!accepting[q]) elements.push_back(q);
+    }
+    const uint32_t nonFinalCount = static_cast<uint32_t>(elements.size());
+    for (uint32_t q = 0; q < n; ++q) {
+        if (accepting[q]) elements.push_back(q);
+    }
+    blockBegin.push_back(0);
+    blockEnd.push_back(nonFinalCount);
+    if (nonFinalCount < n) {
+        blockBegin.push_back(nonFinalCount);
+        blockEnd.push_back(n);
+    }
+    marked.assign(blockBegin.size(), 0);
+    for (uint32_t i = 0; i < n; ++i) {
+        position[elements[i]] = i;
+        blockOf[elements[i]] = i < nonFinalCount ? 0 : 1;
+    }
 
-    // Verifica daca noua stare initială e finala
-    for (const auto& state : initialClosure) {
-        if (finalStates.find(state) != finalStates.end()) {
-            newFinalStates.insert(newInitialState);
-            break;
+    // Lista de spargatori (bloc, simbol); la inceput doar blocul mai mic
+    std::vector<std::pair<uint32_t, uint32_t>> worklist;
+    std::vector<uint8_t> inWorklist(blockBegin.size() * symbolCount, 0);
+    if (blockBegin.size() == 2) {
+        uint32_t smaller = nonFinalCount <= n - nonFinalCount ? 0 : 1;
+        for (uint32_t a = 0; a < symbolCount; ++a) {
+            worklist.push_back({ smaller, a });
+            inWorklist[smaller * symbolCount + a] = 1;
         }
     }
 
-    // Proceseza fiecare stare din coada
-    while (!stateQueue.empty()) {
-        auto currentSet = stateQueue.front();
-        stateQueue.pop();
-        std::string currentStateName = stateMapping[currentSet];
+    std::vector<uint32_t> splitter;
+    std::vector<uint32_t> touched;
+    while (!worklist.empty()) {
+        auto [block, a] = worklist.back();
+        worklist.pop_back();
+        inWorklist[block * symbolCount + a] = 0;
+
+        // Copie, deoarece blocul se poate sparge chiar in aceasta runda
+        splitter.assign(elements.begin() + blockBegin[block], elements.begin() + blockEnd[block]);
+
+        // Marcam predecesorii pe `a`, mutandu-i la inceputul blocului lor
+        for (uint32_t q : splitter) {
+            for (uint32_t i = inverseStart[a * n + q]; i < inverseStart[a * n + q + 1]; ++i) {
+                uint32_t p = inverse[i];
+                uint32_t c = blockOf[p];
+                uint32_t firstUnmarked = blockBegin[c] + marked[c];
+                if (position[p] < firstUnmarked) continue;
+                uint32_t other = elements[firstUnmarked];
+                std::swap(elements[position[p]], elements[firstUnmarked]);
+                position[other] = position[p];
+                position[p] = firstUnmarked;
+                if (marked[c]++ == 0) touched.push_back(c);
+            }
+        }
 
-        // Calculeaza tranzitiile pentru fiecare simbol din alfabet
-        for (const auto& symbol : alphabet) {
-            std::set<std::string> newSet;
+        for (uint32_t c : touched) {
+            uint32_t markedCount = marked[c];
+            marked[c] = 0;
+            uint32_t size = blockEnd[c] - blockBegin[c];
+            if (markedCount == size) continue;
+
+            // Partea marcata devine un bloc nou
+            uint32_t created = static_cast<uint32_t>(blockBegin.size());
+            blockBegin.push_back(blockBegin[c]);
+            blockEnd.push_back(blockBegin[c] + markedCount);
+            marked.push_back(0);
+            blockBegin[c] += markedCount;
+            for (uint32_t i = blockBegin[created]; i < blockEnd[created]; ++i) {
+                blockOf[elements[i]] = created;
+            }
 
-            for (const auto& state : currentSet) {
-                auto range = transitions.equal_range({ state, symbol });
-                for (auto it = range.first; it != range.second; ++it) {
-                    const std::string& targetState = it->second;
-                    // Adauga toate starile din inchiderea /lambda a starii tinta
-                    newSet.insert(lambdaClosure[targetState].begin(), lambdaClosure[targetState].end());
+            inWorklist.resize(blockBegin.size() * symbolCount, 0);
+            uint32_t smaller = markedCount <= size - markedCount ? created : c;
+            for (uint32_t b = 0; b < symbolCount; ++b) {
+                uint32_t chosen = inWorklist[c * symbolCount + b] ? created : smaller;
+                if (!inWorklist[chosen * symbolCount + b]) {
+                    worklist.push_back({ chosen, b });
+                    inWorklist[chosen * symbolCount + b] = 1;
                 }
             }
+        }
+        touched.clear();
+    }
 
-            if (!newSet.empty()) {
-                std::string newSetName;
-                if (stateMapping.find(newSet) == stateMapping.end()) {
-                    // Genereaza un nume pentru noua stare
-                    newSetName = generateStateName(newSet);
-                    stateMapping[newSet] = newSetName;
-                    newStates.insert(newSetName);
-                    stateQueue.push(newSet);
-
-                    // Verifica daca noua stare este finala
-                    for (const auto& state : newSet) {
-                        if (finalStates.find(state) != finalStates.end()) {
-                            newFinalStates.insert(newSetName);
-                            break;
-                        }
-                    }
+    // Numerotare canonica in ordinea BFS din starea initiala; blocul capcanei dispare
+    const uint32_t trapBlock = blockOf[0];
+    std::vector<uint32_t> order(blockBegin.size(), UINT32_MAX);
+    std::vector<uint32_t> queue;
+    uint32_t startBlock = blockOf[start != CompiledAutomaton::kDeadState ? local[start] : 0];
+    if (startBlock != trapBlock) {
+        order[startBlock] = 0;
+        queue.push_back(startBlock);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            uint32_t representative = elements[blockBegin[queue[head]]];
+            for (size_t a = 0; a < symbolCount; ++a) {
+                uint32_t target = blockOf[delta[representative * symbolCount + a]];
+                if (target != trapBlock && order[target] == UINT32_MAX) {
+                    order[target] = static_cast<uint32_t>(queue.size());
+                    queue.push_back(target);
                 }
-                else {
-                    newSetName = stateMapping[newSet];
-                }
-
-                // Adauga tranzitia in noul AFD
-                newTransitions[{currentStateName, symbol}] = newSetName;
             }
         }
     }
 
-    return DeterministicFiniteAutomaton(newStates, newAlphabet, newTransitions, newInitialState, newFinalStates);
+    // Tabelul minimal direct pe aceleasi clase; blocul cu ordinea k devine starea k + 1.
+    // Limbaj vid: o singura stare, nefinala, fara tranzitii.
+    const uint32_t minimalCount = std::max<uint32_t>(static_cast<uint32_t>(queue.size()), 1);
+    CompiledAutomaton minimal(minimalCount + 1, 1, classes);
+    for (uint32_t k = 0; k < queue.size(); ++k) {
+        uint32_t representative = elements[blockBegin[queue[k]]];
+        minimal.setAccepting(k + 1, accepting[representative] != 0);
+        for (uint32_t a = 0; a < symbolCount; ++a) {
+            uint32_t target = blockOf[delta[representative * symbolCount + a]];
+            if (target != trapBlock) minimal.setClassTransition(k + 1, a, order[target] + 1);
+        }
+    }
+    // Clase deosebite doar de stari acum unite pot deveni echivalente
+    minimal.mergeEquivalentClasses();
+
+    REGEX_AFD_RECORD(pipeline.minimalStates = minimalCount;
+        pipeline.minimalTransitions = countByteTransitions(minimal));
+    return minimal;
+}
+
+void PrintMinimizationStats(const MinimizationStats& stats) {
+    std::cerr << "Minimizare AFD: " << stats.statesBefore << " -> " << stats.statesAfter << " stari, "
+        << stats.transitionsBefore << " -> " << stats.transitionsAfter << " tranzitii\n";
+}
+
+bool DeterministicFiniteAutomaton::isEquivalentTo(const DeterministicFiniteAutomaton& other, std::string* counterexample) const {
+    return AreEquivalent(compiled, other.compiled, counterexample);
+}
+
+bool DeterministicFiniteAutomaton::isSubsetOf(const DeterministicFiniteAutomaton& other, std::string* counterexample) const {
+    return IsIncluded(compiled, other.compiled, counterexample);
 }
 
 // Functie auxiliara pentru calcularea inchiderii lambda a unei stari
 std::set<std::string> DeterministicFiniteAutomaton::calculateLambdaClosure(const std::string& state) const {
+    REGEX_AFD_STAGE(PipelineStage::LambdaClosure);
+    const auto& transitions = getNamed().transitions;
     std::set<std::string> closure;
     std::queue<std::string> queue;
 
@@ -1,35 +1,94 @@
-﻿#include <iostream>
+﻿#pragma once
+#include <iostream>
 #include <vector>
 #include <map>
 #include <set>
 #include <stack>
 #include <string>
+#include <string_view>
 #include <queue>
+#include <memory>
+#include "CompiledAutomaton.h"
+#include "LazyDFA.h"
+#include "StateSet.h"
+
+// Numarul de stari si tranzitii inainte si dupa minimizare
+struct MinimizationStats {
+    size_t statesBefore = 0;
+    size_t transitionsBefore = 0;
+    size_t statesAfter = 0;
+    size_t transitionsAfter = 0;
+};
+
+// Starile AFN din care provine fiecare stare S<i> a AFD; folosit doar la afisare
+struct SubsetOrigin {
+    std::vector<std::string> nfaStateNames;
+    std::vector<StateSet> subsets;
+};
 
 class DeterministicFiniteAutomaton {
 private:
-    std::set<std::string> states;
+    // Forma cu nume de tip string; pentru automatele construite direct pe tabel
+    // (determinizare, minimizare) se genereaza abia la prima cerere, pentru afisare
+    struct NamedForm {
+        std::set<std::string> states;
+        std::map<std::pair<std::string, char>, std::string> transitions;
+        std::string initialState;
+        std::set<std::string> finalStates;
+    };
+
     std::set<char> alphabet;
-    std::map<std::pair<std::string, char>, std::string> transitions;
-    std::string initialState;
-    std::set<std::string> finalStates;
+
+    // Forma densa folosita de CheckWord si de minimizare
+    CompiledAutomaton compiled;
+    // Starea compilata i (i >= 1) se numeste statePrefix + (i - 1)
+    std::string statePrefix;
+    mutable std::shared_ptr<const NamedForm> named;
+
+    std::shared_ptr<const SubsetOrigin> subsetOrigin;
+
+    void compile();
+    const NamedForm& getNamed() const;
 
 public:
     DeterministicFiniteAutomaton();
     DeterministicFiniteAutomaton(const std::set<std::string>& Q, const std::set<char>& A,
         const std::map<std::pair<std::string, char>, std::string>& T,
         const std::string& q0, const std::set<std::string>& F);
+    // Automat dat direct prin tabel; starea moarta 0 nu primeste nume
+    DeterministicFiniteAutomaton(CompiledAutomaton automaton, const std::set<char>& A, std::string prefix);
 
     const std::set<std::string>& getStates() const;
     const std::set<char>& getAlphabet() const;
     const std::map<std::pair<std::string, char>, std::string>& getTransitions() const;
     const std::string& getInitialState() const;
     const std::set<std::string>& getFinalStates() const;
+    // Acelasi numar ca getStates().size(), fara a genera numele
+    size_t getStateCount() const;
+    const CompiledAutomaton& getCompiled() const;
+    void setSubsetOrigin(std::shared_ptr<const SubsetOrigin> origin);
     bool VerifyAutomaton() const;
     void PrintAutomaton() const;
     bool CheckWord(const std::string& word) const;
-    DeterministicFiniteAutomaton buildLambdaNFA(const std::string& polishExpression);
-    DeterministicFiniteAutomaton convertToDFA() const;
+    // Verifica mai multe cuvinte deodata; bitul i din rezultat corespunde lui words[i]
+    std::vector<uint64_t> CheckWords(const std::vector<std::string_view>& words) const;
+    // threadCount: numarul de fire pentru constructia submultimilor (0 = toate nucleele)
+    DeterministicFiniteAutomaton convertToDFA(unsigned threadCount = 1) const;
+    // Alternativa la convertToDFA: starile AFD se construiesc doar la cerere
+    LazyDFA convertToLazyDFA(const LazyDFA::Options& options = LazyDFA::Options()) const;
+    // Minimizare Hopcroft; elimina si starile inaccesibile sau moarte
+    DeterministicFiniteAutomaton minimize(MinimizationStats* stats = nullptr) const;
+    // L(this) = L(other) si L(this) ⊆ L(other), pe formele compilate (vezi AutomatonEquivalence.h);
+    // la raspuns negativ `counterexample` primeste un cuvant care le deosebeste
+    bool isEquivalentTo(const DeterministicFiniteAutomaton& other, std::string* counterexample = nullptr) const;
+    bool isSubsetOf(const DeterministicFiniteAutomaton& other, std::string* counterexample = nullptr) const;
     std::set<std::string> calculateLambdaClosure(const std::string& state) const;
     std::string generateStateName(const std::set<std::string>& stateSet) const;
 };
+
+// La stderr, ca linia sa nu se amestece cu rezultatele scrise la stdout
+void PrintMinimizationStats(const MinimizationStats& stats);
+
+// Hopcroft direct pe tabel, pe clasele lui de octeti: fara stari inaccesibile sau
+// moarte, numerotat in ordinea BFS din starea initiala 1
+CompiledAutomaton MinimizeAutomaton(const CompiledAutomaton& automaton);
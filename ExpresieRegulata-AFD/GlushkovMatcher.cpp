@@ -0,0 +1,138 @@
+﻿#include "GlushkovMatcher.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Atributele Glushkov ale unei subexpresii
+struct PositionSets {
+    bool nullable;
+    uint64_t first;
+    uint64_t last;
+};
+
+// follow[i] |= targets pentru fiecare pozitie i din `from`
+void addFollow(std::vector<uint64_t>& follow, uint64_t from, uint64_t targets) {
+    while (from) {
+        unsigned position = 0;
+        while (!((from >> position) & 1)) ++position;
+        follow[position] |= targets;
+        from &= from - 1;
+    }
+}
+
+}
+
+GlushkovMatcher::GlushkovMatcher()
+    : positionCount(0), usedChunks(1), acceptMask(0) {
+    std::memset(byteMasks, 0, sizeof(byteMasks));
+    std::memset(followTable, 0, sizeof(followTable));
+}
+
+bool GlushkovMatcher::fromPolishNotation(const std::string& polishExpression, GlushkovMatcher& result) {
+    RegexAst ast;
+    return RegexAst::fromPolishNotation(polishExpression, ast) && fromAst(ast, result);
+}
+
+bool GlushkovMatcher::fromAst(const RegexAst& ast, GlushkovMatcher& result) {
+    GlushkovMatcher matcher;
+    std::vector<uint64_t> follow(kMaxPositions + 1, 0);
+    std::vector<PositionSets> stack;
+
+    for (const RegexAst::Node& node : ast.getNodes()) {
+        switch (node.kind) {
+        case RegexAst::Node::Kind::Empty:
+            stack.push_back({ true, 0, 0 });
+            break;
+        case RegexAst::Node::Kind::Set: {
+            if (matcher.positionCount == kMaxPositions) return false;
+            const uint64_t bit = uint64_t(1) << ++matcher.positionCount;
+            const std::bitset<256>& bytes = ast.getSets()[node.set];
+            for (unsigned byte = 0; byte < 256; ++byte) {
+                if (bytes.test(byte)) matcher.byteMasks[byte] |= bit;
+            }
+            stack.push_back({ false, bit, bit });
+            break;
+        }
+        case RegexAst::Node::Kind::Concat:
+        case RegexAst::Node::Kind::Alternate: {
+            PositionSets b = stack.back(); stack.pop_back();
+            PositionSets a = stack.back(); stack.pop_back();
+            if (node.kind == RegexAst::Node::Kind::Alternate) {
+                stack.push_back({ a.nullable || b.nullable, a.first | b.first, a.last | b.last });
+            }
+            else {
+                addFollow(follow, a.last, b.first);
+                stack.push_back({ a.nullable && b.nullable,
+                    a.first | (a.nullable ? b.first : 0),
+                    b.last | (b.nullable ? a.last : 0) });
+            }
+            break;
+        }
+        case RegexAst::Node::Kind::Repeat: {
+            // *, + si ? nu adauga pozitii; {m,n} ar cere copii ale operandului
+            PositionSets& a = stack.back();
+            if (node.max == RegexAst::kUnbounded && node.min <= 1) {
+                addFollow(follow, a.last, a.first);
+                a.nullable = a.nullable || node.min == 0;
+            }
+            else if (node.min == 0 && node.max == 1) {
+                a.nullable = true;
+            }
+            else {
+                return false;
+            }
+            break;
+        }
+        }
+    }
+    if (stack.size() != 1) return false;
+
+    // Din starea initiala (bitul 0) se trece in pozitiile first
+    follow[0] = stack.back().first;
+    matcher.acceptMask = stack.back().last | (stack.back().nullable ? 1 : 0);
+
+    matcher.usedChunks = matcher.positionCount / kChunkBits + 1;
+    for (uint32_t chunk = 0; chunk < matcher.usedChunks; ++chunk) {
+        for (uint32_t value = 1; value < 256; ++value) {
+            // Se refoloseste intrarea pentru value fara bitul cel mai mic
+            uint32_t lowest = 0;
+            while (!((value >> lowest) & 1)) ++lowest;
+            const uint32_t position = chunk * kChunkBits + lowest;
+            matcher.followTable[chunk][value] = matcher.followTable[chunk][value & (value - 1)]
+                | (position <= kMaxPositions ? follow[position] : 0);
+        }
+    }
+
+    result = matcher;
+    return true;
+}
+
+bool GlushkovMatcher::CheckWord(std::string_view word) const {
+    uint64_t active = 1; // doar starea initiala
+
+    for (unsigned char symbol : word) {
+        active = follow(active) & byteMasks[symbol];
+        if (!active) {
+            return false;
+        }
+    }
+
+    return (active & acceptMask) != 0;
+}
+
+bool GlushkovMatcher::search(std::string_view text) const {
+    if (acceptMask & 1) {
+        return true;
+    }
+
+    uint64_t active = 0;
+    for (unsigned char symbol : text) {
+        // Starea initiala ramane activa: o potrivire poate incepe oriunde
+        active = follow(active | 1) & byteMasks[symbol];
+        if (active & acceptMask) {
+            return true;
+        }
+    }
+    return false;
+}
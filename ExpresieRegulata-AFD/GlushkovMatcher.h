@@ -0,0 +1,48 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "RegexParser.h"
+
+// Automatul pozitiilor (Glushkov) al unei expresii, fara λ-tranzitii si fara
+// determinizare. Fiecare multime de octeti din arbore este o pozitie; multimea
+// pozitiilor active incape intr-un cuvant de 64 de biti si avanseaza pe un
+// octet prin cateva citiri din tabele si un SI logic.
+class GlushkovMatcher {
+public:
+    // Bitul 0 este starea initiala, deci raman 63 de pozitii pentru operanzi
+    static constexpr uint32_t kMaxPositions = 63;
+
+    GlushkovMatcher();
+
+    // Fals daca arborele are mai mult de kMaxPositions multimi de octeti sau
+    // repetari {m,n} (altele decat *, + si ?)
+    static bool fromAst(const RegexAst& ast, GlushkovMatcher& result);
+    // Aceeasi forma poloneza ca buildLambdaNFA; fals si daca expresia e invalida
+    static bool fromPolishNotation(const std::string& polishExpression, GlushkovMatcher& result);
+
+    uint32_t getPositionCount() const { return positionCount; }
+    bool CheckWord(std::string_view word) const;
+    // Adevarat daca un subsir al textului (eventual vid) este in limbaj
+    bool search(std::string_view text) const;
+
+private:
+    static constexpr uint32_t kChunkBits = 8;
+    static constexpr uint32_t kChunkCount = 64 / kChunkBits;
+
+    // Reuniunea multimilor follow pentru pozitiile active
+    uint64_t follow(uint64_t active) const {
+        uint64_t result = 0;
+        for (uint32_t chunk = 0; chunk < usedChunks; ++chunk) {
+            result |= followTable[chunk][(active >> (chunk * kChunkBits)) & 0xFF];
+        }
+        return result;
+    }
+
+    uint32_t positionCount;
+    uint32_t usedChunks;
+    uint64_t acceptMask;        // pozitiile finale; bitul 0 daca limbajul contine cuvantul vid
+    uint64_t byteMasks[256];    // pozitiile etichetate cu fiecare octet
+    // followTable[k][v]: reuniunea follow pentru pozitiile 8k..8k+7 selectate de bitii lui v
+    uint64_t followTable[kChunkCount][256];
+};
@@ -0,0 +1,730 @@
+﻿#include "LambdaNFA.h"
+#include "DeterministicFiniteAutomaton.h"
+#include "ParallelSubsetConstruction.h"
+#include "PipelineStats.h"
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+LambdaNFA::LambdaNFA()
+    : initialState(0), accepting(1, 0), acceptTags(1, 0), edgeStart(2, 0), lambdaStart(2, 0) {
+}
+
+std::string LambdaNFA::getStateName(uint32_t state) const {
+    return state < names.size() ? names[state] : "q" + std::to_string(state);
+}
+
+void LambdaNFA::assignEdges(const std::vector<SymbolEdge>& symbolEdges, const std::vector<LambdaEdge>& lambdaPairs) {
+    const uint32_t count = getStateCount();
+
+    edgeStart.assign(count + 1, 0);
+    for (const auto& [from, edge] : symbolEdges) ++edgeStart[from + 1];
+    for (uint32_t state = 0; state < count; ++state) edgeStart[state + 1] += edgeStart[state];
+    edges.resize(symbolEdges.size());
+    std::vector<uint32_t> fill(edgeStart.begin(), edgeStart.end() - 1);
+    for (const auto& [from, edge] : symbolEdges) edges[fill[from]++] = edge;
+
+    lambdaStart.assign(count + 1, 0);
+    for (const auto& [from, target] : lambdaPairs) ++lambdaStart[from + 1];
+    for (uint32_t state = 0; state < count; ++state) lambdaStart[state + 1] += lambdaStart[state];
+    lambdaEdges.resize(lambdaPairs.size());
+    fill.assign(lambdaStart.begin(), lambdaStart.end() - 1);
+    for (const auto& [from, target] : lambdaPairs) lambdaEdges[fill[from]++] = target;
+}
+
+void LambdaNFA::collectEdges(std::vector<SymbolEdge>& symbolEdges, std::vector<LambdaEdge>& lambdaPairs,
+    uint32_t offset) const {
+    for (uint32_t state = 0; state < getStateCount(); ++state) {
+        for (const RangeEdge& edge : getEdges(state)) {
+            symbolEdges.push_back({ state + offset, { edge.low, edge.high, edge.target + offset } });
+        }
+        for (uint32_t target : getLambdaEdges(state)) {
+            lambdaPairs.push_back({ state + offset, target + offset });
+        }
+    }
+}
+
+LambdaNFA LambdaNFA::fromAutomaton(const DeterministicFiniteAutomaton& automaton) {
+    REGEX_AFD_STAGE(PipelineStage::LambdaNFA);
+    LambdaNFA nfa;
+    nfa.names.clear();
+    std::unordered_map<std::string, uint32_t> ids;
+    for (const auto& state : automaton.getStates()) {
+        ids.emplace(state, static_cast<uint32_t>(nfa.names.size()));
+        nfa.names.push_back(state);
+    }
+
+    // Starea initiala lipsa devine o stare izolata, ca limbajul sa fie vid
+    auto initialIt = ids.find(automaton.getInitialState());
+    if (initialIt == ids.end()) {
+        nfa.initialState = static_cast<uint32_t>(nfa.names.size());
+        nfa.names.push_back(automaton.getInitialState());
+    }
+    else {
+        nfa.initialState = initialIt->second;
+    }
+
+    const size_t count = nfa.names.size();
+    nfa.accepting.assign(count, 0);
+    nfa.acceptTags.assign(count, 0);
+
+    for (const auto& symbol : automaton.getAlphabet()) {
+        if (symbol != '\0') nfa.alphabet.insert(symbol);
+    }
+
+    std::vector<SymbolEdge> symbolEdges;
+    std::vector<LambdaEdge> lambdaPairs;
+    for (const auto& [key, value] : automaton.getTransitions()) {
+        const auto& [state, symbol] = key;
+        auto fromIt = ids.find(state);
+        auto toIt = ids.find(value);
+        if (fromIt == ids.end() || toIt == ids.end()) continue;
+
+        if (symbol == '\0') {
+            lambdaPairs.push_back({ fromIt->second, toIt->second });
+        }
+        else if (nfa.alphabet.count(symbol)) {
+            const unsigned char byte = static_cast<unsigned char>(symbol);
+            symbolEdges.push_back({ fromIt->second, { byte, byte, toIt->second } });
+        }
+    }
+    nfa.assignEdges(symbolEdges, lambdaPairs);
+
+    for (const auto& finalState : automaton.getFinalStates()) {
+        auto it = ids.find(finalState);
+        if (it != ids.end()) nfa.accepting[it->second] = 1;
+    }
+    REGEX_AFD_RECORD(pipeline.nfaStates = nfa.getStateCount(); pipeline.nfaTransitions = nfa.edges.size();
+        pipeline.nfaLambdaTransitions = nfa.lambdaEdges.size());
+
+    return nfa;
+}
+
+LambdaNFA LambdaNFA::fromAutomaton(const CompiledAutomaton& automaton) {
+    const uint32_t count = automaton.getStateCount();
+    LambdaNFA nfa;
+    nfa.initialState = automaton.getStartState();
+    nfa.accepting.assign(count, 0);
+    nfa.acceptTags.assign(count, 0);
+
+    // Octetii consecutivi cu aceeasi destinatie devin o singura muchie
+    std::vector<SymbolEdge> symbolEdges;
+    for (uint32_t state = 1; state < count; ++state) {
+        nfa.accepting[state] = automaton.isAccepting(state);
+        unsigned low = 0;
+        for (unsigned byte = 1; byte <= CompiledAutomaton::kAlphabetSize; ++byte) {
+            const uint32_t target = automaton.next(state, static_cast<unsigned char>(low));
+            if (byte < CompiledAutomaton::kAlphabetSize && automaton.next(state, static_cast<unsigned char>(byte)) == target) {
+                continue;
+            }
+            if (target != CompiledAutomaton::kDeadState) {
+                symbolEdges.push_back({ state, { static_cast<unsigned char>(low), static_cast<unsigned char>(byte - 1), target } });
+            }
+            low = byte;
+        }
+    }
+    nfa.assignEdges(symbolEdges, {});
+    return nfa;
+}
+
+bool LambdaNFA::fromExpression(const std::string& expression, LambdaNFA& result, RegexError* error) {
+    RegexAst ast;
+    RegexError parseError;
+    if (!RegexAst::parse(expression, ast, &parseError)) {
+        if (error) *error = parseError;
+        else PrintRegexError(expression, parseError);
+        return false;
+    }
+
+    result = buildLambdaNFA(ast);
+    return true;
+}
+
+LambdaNFA LambdaNFA::reversed() const {
+    const uint32_t count = getStateCount();
+    LambdaNFA nfa;
+    nfa.alphabet = alphabet;
+    nfa.names = names;
+    if (!nfa.names.empty()) nfa.names.push_back("rev");
+    nfa.initialState = count;
+    nfa.accepting.assign(count + 1, 0);
+    nfa.accepting[initialState] = 1;
+    nfa.acceptTags.assign(count + 1, 0);
+
+    std::vector<SymbolEdge> symbolEdges;
+    std::vector<LambdaEdge> lambdaPairs;
+    for (uint32_t state = 0; state < count; ++state) {
+        for (const RangeEdge& edge : getEdges(state)) {
+            symbolEdges.push_back({ edge.target, { edge.low, edge.high, state } });
+        }
+        for (uint32_t target : getLambdaEdges(state)) {
+            lambdaPairs.push_back({ target, state });
+        }
+        if (accepting[state]) {
+            lambdaPairs.push_back({ count, state });
+        }
+    }
+    nfa.assignEdges(symbolEdges, lambdaPairs);
+
+    return nfa;
+}
+
+LambdaNFA LambdaNFA::unanchored() const {
+    const uint32_t count = getStateCount();
+    LambdaNFA nfa;
+    nfa.alphabet = alphabet;
+    nfa.names = names;
+    if (!nfa.names.empty()) nfa.names.push_back("any");
+    nfa.initialState = count;
+    nfa.accepting = accepting;
+    nfa.accepting.push_back(0);
+    nfa.acceptTags = acceptTags;
+    nfa.acceptTags.push_back(0);
+
+    std::vector<SymbolEdge> symbolEdges;
+    std::vector<LambdaEdge> lambdaPairs;
+    collectEdges(symbolEdges, lambdaPairs);
+    symbolEdges.push_back({ count, { 0, 255, count } });
+    for (unsigned symbol = 0; symbol < 256; ++symbol) {
+        nfa.alphabet.insert(static_cast<char>(symbol));
+    }
+    lambdaPairs.push_back({ count, initialState });
+    nfa.assignEdges(symbolEdges, lambdaPairs);
+
+    return nfa;
+}
+
+LambdaNFA LambdaNFA::combine(const std::vector<LambdaNFA>& nfas) {
+    LambdaNFA nfa;
+    std::vector<SymbolEdge> symbolEdges;
+    std::vector<LambdaEdge> lambdaPairs;
+
+    for (uint32_t pattern = 0; pattern < nfas.size(); ++pattern) {
+        const LambdaNFA& part = nfas[pattern];
+        const uint32_t offset = nfa.getStateCount();
+        lambdaPairs.push_back({ 0, offset + part.initialState });
+        nfa.alphabet.insert(part.alphabet.begin(), part.alphabet.end());
+        part.collectEdges(symbolEdges, lambdaPairs, offset);
+
+        nfa.accepting.insert(nfa.accepting.end(), part.accepting.begin(), part.accepting.end());
+        nfa.acceptTags.insert(nfa.acceptTags.end(), part.getStateCount(), pattern);
+    }
+    nfa.assignEdges(symbolEdges, lambdaPairs);
+
+    return nfa;
+}
+
+namespace {
+
+// Stare din arena constructiei Thompson: cel mult doua iesiri
+struct ThompsonState {
+    enum Kind : uint8_t { Set, Split, Lambda, Accept };
+    Kind kind;
+    uint32_t ranges; // Set: indexul listei de intervale
+    uint32_t out;
+    uint32_t out1;
+};
+
+constexpr uint32_t kNoSlot = UINT32_MAX;
+
+// Un fragment retine doar starea de start si lista iesirilor nelegate. Lista e
+// inlantuita prin chiar campurile libere out/out1 (slot = 2 * stare + 0/1).
+struct Fragment {
+    uint32_t start;
+    uint32_t patchHead;
+    uint32_t patchTail;
+};
+
+uint32_t& slotRef(std::vector<ThompsonState>& arena, uint32_t slot) {
+    ThompsonState& state = arena[slot >> 1];
+    return (slot & 1) ? state.out1 : state.out;
+}
+
+void patch(std::vector<ThompsonState>& arena, uint32_t head, uint32_t target) {
+    while (head != kNoSlot) {
+        uint32_t& ref = slotRef(arena, head);
+        head = ref;
+        ref = target;
+    }
+}
+
+Fragment appendLists(std::vector<ThompsonState>& arena, uint32_t start, const Fragment& a, const Fragment& b) {
+    slotRef(arena, a.patchTail) = b.patchHead;
+    return { start, a.patchHead, b.patchTail };
+}
+
+uint32_t addState(std::vector<ThompsonState>& arena, ThompsonState::Kind kind, uint32_t ranges,
+    uint32_t out, uint32_t out1) {
+    arena.push_back({ kind, ranges, out, out1 });
+    return static_cast<uint32_t>(arena.size() - 1);
+}
+
+// Constructia Thompson peste nodurile in postordine ale arborelui
+class ThompsonBuilder {
+public:
+    explicit ThompsonBuilder(const RegexAst& ast) : ast(ast), nodes(ast.getNodes()) {}
+
+    std::vector<ThompsonState> arena;
+    // Intervalele fiecarei multimi distincte de octeti din arbore
+    std::vector<std::vector<std::pair<unsigned char, unsigned char>>> ranges;
+    std::set<char> alphabet;
+
+    // Fragmentul subarborelui [first, last]
+    Fragment build(uint32_t first, uint32_t last) {
+        std::vector<Fragment> fragments;
+        for (uint32_t index = first; index <= last; ++index) {
+            const RegexAst::Node& node = nodes[index];
+            switch (node.kind) {
+            case RegexAst::Node::Kind::Empty: {
+                uint32_t state = addState(arena, ThompsonState::Lambda, 0, kNoSlot, kNoSlot);
+                fragments.push_back({ state, state * 2, state * 2 });
+                break;
+            }
+            case RegexAst::Node::Kind::Set: {
+                uint32_t state = addState(arena, ThompsonState::Set, rangesOf(node.set), kNoSlot, kNoSlot);
+                fragments.push_back({ state, state * 2, state * 2 });
+                break;
+            }
+            case RegexAst::Node::Kind::Concat: {
+                Fragment second = fragments.back(); fragments.pop_back();
+                Fragment first = fragments.back(); fragments.pop_back();
+                fragments.push_back(concatenate(first, second));
+                break;
+            }
+            case RegexAst::Node::Kind::Alternate: {
+                Fragment second = fragments.back(); fragments.pop_back();
+                Fragment first = fragments.back(); fragments.pop_back();
+                uint32_t split = addState(arena, ThompsonState::Split, 0, first.start, second.start);
+                fragments.push_back(appendLists(arena, split, first, second));
+                break;
+            }
+            case RegexAst::Node::Kind::Repeat: {
+                Fragment inner = fragments.back(); fragments.pop_back();
+                fragments.push_back(repeat(node, inner));
+                break;
+            }
+            }
+        }
+        return fragments.back();
+    }
+
+private:
+    uint32_t rangesOf(uint32_t set) {
+        const std::bitset<256>& bytes = ast.getSets()[set];
+        auto [it, inserted] = rangeIndex.emplace(bytes, static_cast<uint32_t>(ranges.size()));
+        if (!inserted) return it->second;
+
+        ranges.emplace_back();
+        for (unsigned low = 0; low < 256;) {
+            if (!bytes.test(low)) {
+                ++low;
+                continue;
+            }
+            unsigned high = low;
+            while (high + 1 < 256 && bytes.test(high + 1)) ++high;
+            ranges.back().push_back({ static_cast<unsigned char>(low), static_cast<unsigned char>(high) });
+            for (unsigned byte = low; byte <= high; ++byte) alphabet.insert(static_cast<char>(byte));
+            low = high + 1;
+        }
+        return it->second;
+    }
+
+    Fragment concatenate(const Fragment& first, const Fragment& second) {
+        patch(arena, first.patchHead, second.start);
+        return { first.start, second.patchHead, second.patchTail };
+    }
+
+    // x* : split -> x -> split
+    Fragment star(const Fragment& inner) {
+        uint32_t split = addState(arena, ThompsonState::Split, 0, inner.start, kNoSlot);
+        patch(arena, inner.patchHead, split);
+        return { split, split * 2 + 1, split * 2 + 1 };
+    }
+
+    // x+ : x -> split -> x
+    Fragment plus(const Fragment& inner) {
+        uint32_t split = addState(arena, ThompsonState::Split, 0, inner.start, kNoSlot);
+        patch(arena, inner.patchHead, split);
+        return { inner.start, split * 2 + 1, split * 2 + 1 };
+    }
+
+    // x{min,max}: min copii obligatorii, apoi x* / x+ sau max - min copii optionale
+    // imbricate, x(x(x)?)?, ca fiecare optiune sa aiba o singura iesire spre final
+    Fragment repeat(const RegexAst::Node& node, const Fragment& inner) {
+        const RegexAst::Node& operand = nodes[node.left];
+        bool innerUsed = false;
+        auto copy = [&]() {
+            if (!innerUsed) {
+                innerUsed = true;
+                return inner;
+            }
+            return build(operand.first, node.left);
+        };
+
+        const bool unbounded = node.max == RegexAst::kUnbounded;
+        if (unbounded && node.min == 0) return star(copy());
+
+        bool hasResult = false;
+        Fragment result{};
+        auto append = [&](const Fragment& next) {
+            result = hasResult ? concatenate(result, next) : next;
+            hasResult = true;
+        };
+
+        for (uint32_t i = 0; i < node.min; ++i) {
+            Fragment next = copy();
+            append(unbounded && i + 1 == node.min ? plus(next) : next);
+        }
+
+        if (!unbounded && node.max > node.min) {
+            Fragment chain{};
+            Fragment previous{};
+            for (uint32_t i = node.min; i < node.max; ++i) {
+                Fragment next = copy();
+                uint32_t split = addState(arena, ThompsonState::Split, 0, next.start, kNoSlot);
+                if (i == node.min) {
+                    chain = { split, split * 2 + 1, split * 2 + 1 };
+                }
+                else {
+                    patch(arena, previous.patchHead, split);
+                    slotRef(arena, chain.patchTail) = split * 2 + 1;
+                    chain.patchTail = split * 2 + 1;
+                }
+                previous = next;
+            }
+            chain = appendLists(arena, chain.start, chain, previous);
+            append(chain);
+        }
+
+        if (!innerUsed) {
+            // x{0}: operandul construit deja ramane inaccesibil, dar iesirile lui trebuie
+            // legate undeva, altfel devin muchii spre stari inexistente (parserul da
+            // oricum un nod vid; aici ajung doar arborii construiti altfel)
+            patch(arena, inner.patchHead, inner.start);
+        }
+        if (!hasResult) {
+            uint32_t state = addState(arena, ThompsonState::Lambda, 0, kNoSlot, kNoSlot);
+            result = { state, state * 2, state * 2 };
+        }
+        return result;
+    }
+
+    const RegexAst& ast;
+    const std::vector<RegexAst::Node>& nodes;
+    std::unordered_map<std::bitset<256>, uint32_t> rangeIndex;
+};
+
+}
+
+LambdaNFA buildLambdaNFA(const RegexAst& ast) {
+    REGEX_AFD_STAGE(PipelineStage::LambdaNFA);
+    ThompsonBuilder builder(ast);
+    builder.arena.reserve(ast.getNodes().size() + 1);
+    Fragment root = builder.build(0, ast.getRoot());
+
+    std::vector<ThompsonState>& arena = builder.arena;
+    uint32_t accept = addState(arena, ThompsonState::Accept, 0, kNoSlot, kNoSlot);
+    patch(arena, root.patchHead, accept);
+
+    // Arena devine AFN-ul compact: multime -> o muchie per interval, split -> doua λ-tranzitii
+    LambdaNFA nfa;
+    const uint32_t count = static_cast<uint32_t>(arena.size());
+    nfa.initialState = root.start;
+    nfa.accepting.assign(count, 0);
+    nfa.acceptTags.assign(count, 0);
+    nfa.alphabet = std::move(builder.alphabet);
+
+    std::vector<LambdaNFA::SymbolEdge> symbolEdges;
+    std::vector<LambdaNFA::LambdaEdge> lambdaPairs;
+    symbolEdges.reserve(count);
+    lambdaPairs.reserve(count * 2);
+    for (uint32_t state = 0; state < count; ++state) {
+        const ThompsonState& current = arena[state];
+        switch (current.kind) {
+        case ThompsonState::Set:
+            for (const auto& [low, high] : builder.ranges[current.ranges]) {
+                symbolEdges.push_back({ state, { low, high, current.out } });
+            }
+            break;
+        case ThompsonState::Split:
+            lambdaPairs.push_back({ state, current.out });
+            lambdaPairs.push_back({ state, current.out1 });
+            break;
+        case ThompsonState::Lambda:
+            lambdaPairs.push_back({ state, current.out });
+            break;
+        case ThompsonState::Accept:
+            nfa.accepting[state] = 1;
+            break;
+        }
+    }
+    nfa.assignEdges(symbolEdges, lambdaPairs);
+    REGEX_AFD_RECORD(pipeline.nfaStates = nfa.getStateCount(); pipeline.nfaTransitions = nfa.edges.size();
+        pipeline.nfaLambdaTransitions = nfa.lambdaEdges.size());
+
+    return nfa;
+}
+
+LambdaNFA buildLambdaNFA(const std::string& polishExpression) {
+    RegexAst ast;
+    RegexError error;
+    if (!RegexAst::fromPolishNotation(polishExpression, ast, &error)) {
+        std::cerr << "Eroare: " << error.message << ".\n";
+        return LambdaNFA();
+    }
+    return buildLambdaNFA(ast);
+}
+
+std::vector<StateSet> LambdaNFA::computeLambdaClosures() const {
+    REGEX_AFD_STAGE(PipelineStage::LambdaClosure);
+    const uint32_t count = getStateCount();
+    std::vector<StateSet> closures(count, StateSet(count));
+    std::vector<uint32_t> pending;
+
+    for (uint32_t state = 0; state < count; ++state) {
+        StateSet& closure = closures[state];
+        closure.insert(state);
+        pending.push_back(state);
+        while (!pending.empty()) {
+            uint32_t current = pending.back();
+            pending.pop_back();
+            for (uint32_t target : getLambdaEdges(current)) {
+                if (!closure.contains(target)) {
+                    closure.insert(target);
+                    pending.push_back(target);
+                }
+            }
+        }
+        REGEX_AFD_RECORD(pipeline.peakClosureSize = std::max<uint64_t>(pipeline.peakClosureSize, closure.count()));
+    }
+
+    return closures;
+}
+
+namespace {
+
+// Multimile sunt tinute o singura data in `sets`; tabela de hash retine doar indici
+struct SetIndexHash {
+    const std::vector<StateSet>* sets;
+    size_t operator()(uint32_t index) const { return (*sets)[index].hash(); }
+};
+
+struct SetIndexEqual {
+    const std::vector<StateSet>* sets;
+    bool operator()(uint32_t a, uint32_t b) const { return (*sets)[a] == (*sets)[b]; }
+};
+
+}
+
+ByteClasses LambdaNFA::computeByteClasses() const {
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> pairs(ByteClasses::kMaxClasses);
+    for (uint32_t state = 0; state < getStateCount(); ++state) {
+        for (const RangeEdge& edge : getEdges(state)) {
+            for (unsigned byte = edge.low; byte <= edge.high; ++byte) pairs[byte].push_back({ state, edge.target });
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> keys(ByteClasses::kMaxClasses);
+    for (uint32_t byte = 0; byte < ByteClasses::kMaxClasses; ++byte) {
+        std::sort(pairs[byte].begin(), pairs[byte].end());
+        pairs[byte].erase(std::unique(pairs[byte].begin(), pairs[byte].end()), pairs[byte].end());
+        for (const auto& [from, target] : pairs[byte]) {
+            keys[byte].push_back(from);
+            keys[byte].push_back(target);
+        }
+    }
+    return ByteClasses::fromKeys(keys);
+}
+
+LambdaNFA::ClassEdges LambdaNFA::computeClassEdges(const ByteClasses& classes) const {
+    ClassEdges result;
+    result.start.reserve(getStateCount() + 1);
+    result.start.push_back(0);
+
+    auto byClassThenTarget = [](const Edge& a, const Edge& b) {
+        return a.symbol != b.symbol ? a.symbol < b.symbol : a.target < b.target;
+    };
+    auto sameEdge = [](const Edge& a, const Edge& b) { return a.symbol == b.symbol && a.target == b.target; };
+
+    for (uint32_t state = 0; state < getStateCount(); ++state) {
+        const size_t first = result.edges.size();
+        for (const RangeEdge& edge : getEdges(state)) {
+            // Octetii consecutivi ai unui interval cad de obicei in aceeasi clasa
+            uint32_t previous = ByteClasses::kMaxClasses;
+            for (unsigned byte = edge.low; byte <= edge.high; ++byte) {
+                const uint32_t byteClass = classes.classOf(static_cast<unsigned char>(byte));
+                if (byteClass != previous) result.edges.push_back({ static_cast<unsigned char>(byteClass), edge.target });
+                previous = byteClass;
+            }
+        }
+        std::sort(result.edges.begin() + first, result.edges.end(), byClassThenTarget);
+        result.edges.erase(std::unique(result.edges.begin() + first, result.edges.end(), sameEdge), result.edges.end());
+        result.start.push_back(static_cast<uint32_t>(result.edges.size()));
+    }
+    return result;
+}
+
+SubsetConstruction LambdaNFA::determinize(unsigned threadCount) const {
+    if (threadCount != 1) {
+        return determinizeParallel(*this, threadCount);
+    }
+
+    SubsetConstruction result;
+    determinize(DeterminizeLimits(), result);
+    return result;
+}
+
+bool LambdaNFA::determinize(const DeterminizeLimits& limits, SubsetConstruction& result) const {
+    const uint32_t count = getStateCount();
+    const size_t setBytes = sizeof(StateSet) + (count + 63) / 64 * sizeof(uint64_t);
+    const size_t maxBytes = limits.maxBytes ? limits.maxBytes : SIZE_MAX;
+    const size_t maxStates = limits.maxStates ? limits.maxStates : SIZE_MAX;
+    // Inchiderile singure ocupa count * setBytes; pentru AFN foarte mari depasesc deja bugetul
+    if (count > maxBytes / setBytes) {
+        return false;
+    }
+    const std::vector<StateSet> closures = computeLambdaClosures();
+
+    // Acumulatorii sunt pe clase de octeti, nu pe simbolurile alfabetului
+    result = SubsetConstruction();
+    result.classes = computeByteClasses();
+    const ClassEdges classEdges = computeClassEdges(result.classes);
+    const uint32_t classCount = result.classes.getClassCount();
+
+    std::vector<StateSet>& sets = result.sets;
+    std::unordered_set<uint32_t, SetIndexHash, SetIndexEqual> interned(
+        16, SetIndexHash{ &sets }, SetIndexEqual{ &sets });
+
+    sets.push_back(closures[initialState]);
+    interned.insert(0);
+
+    std::vector<StateSet> successors(classCount, StateSet(count));
+    std::vector<uint32_t> touched;
+    std::vector<uint8_t> isTouched(classCount, 0);
+    // Tabela de hash retine cam doi pointeri si un indice per multime. Dupa constructie
+    // fiecare stare AFD mai ocupa un rand in tabelul compilat, iar minimizarea aloca
+    // cateva tablouri de aceeasi forma (delta, tranzitiile inverse, predecesorii,
+    // spargatorii, tabelul minimal): in total cam zece randuri de classCount cuvinte.
+    const size_t fixedBytes = (count + classCount) * setBytes;
+    const size_t perSetBytes = setBytes + 3 * sizeof(void*) + 10 * classCount * sizeof(uint32_t) + 64;
+
+    // `sets` creste pe parcurs, deci functioneaza ca o coada BFS
+    for (uint32_t current = 0; current < sets.size(); ++current) {
+        sets[current].forEach([&](uint32_t state) {
+            for (const Edge& edge : classEdges.get(state)) {
+                uint32_t index = edge.symbol;
+                if (!isTouched[index]) {
+                    isTouched[index] = 1;
+                    touched.push_back(index);
+                }
+                successors[index].unite(closures[edge.target]);
+            }
+        });
+
+        std::sort(touched.begin(), touched.end());
+        for (uint32_t index : touched) {
+            // Candidatul se adauga la final si se retrage daca exista deja
+            sets.push_back(successors[index]);
+            successors[index].clear();
+            isTouched[index] = 0;
+            uint32_t candidate = static_cast<uint32_t>(sets.size() - 1);
+            auto [it, inserted] = interned.insert(candidate);
+            if (!inserted) sets.pop_back();
+
+            result.transitions.push_back({ current, static_cast<uint8_t>(index), *it });
+        }
+        touched.clear();
+
+        const size_t bytes = fixedBytes + sets.size() * perSetBytes
+            + result.transitions.size() * sizeof(SubsetConstruction::Transition);
+        if (sets.size() > maxStates || bytes > maxBytes) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+DeterministicFiniteAutomaton LambdaNFA::toDFA(unsigned threadCount) const {
+    REGEX_AFD_STAGE(PipelineStage::SubsetConstruction);
+    return toDFA(determinize(threadCount));
+}
+
+bool LambdaNFA::toDFA(const DeterminizeLimits& limits, DeterministicFiniteAutomaton& result) const {
+    REGEX_AFD_STAGE(PipelineStage::SubsetConstruction);
+    SubsetConstruction construction;
+    if (!determinize(limits, construction)) {
+        return false;
+    }
+    result = toDFA(std::move(construction));
+    return true;
+}
+
+bool LambdaNFA::toMinimalAutomaton(const DeterminizeLimits& limits, CompiledAutomaton& result) const {
+    CompiledAutomaton table;
+    {
+        REGEX_AFD_STAGE(PipelineStage::SubsetConstruction);
+        SubsetConstruction construction;
+        if (!determinize(limits, construction)) {
+            return false;
+        }
+        table = compileConstruction(construction);
+    }
+    // Multimile de stari sunt deja eliberate cand incepe minimizarea
+    result = MinimizeAutomaton(table);
+    return true;
+}
+
+CompiledAutomaton LambdaNFA::compileConstruction(const SubsetConstruction& construction) const {
+    const uint32_t count = getStateCount();
+    const uint32_t dfaStates = static_cast<uint32_t>(construction.sets.size());
+    REGEX_AFD_RECORD(pipeline.dfaStates = dfaStates; pipeline.dfaTransitions = construction.transitions.size();
+        for (const StateSet& set : construction.sets) pipeline.peakSubsetSize = std::max<uint64_t>(pipeline.peakSubsetSize, set.count()));
+
+    StateSet acceptingSet(count);
+    for (uint32_t state = 0; state < count; ++state) {
+        if (accepting[state]) acceptingSet.insert(state);
+    }
+
+    // Tabelul se completeaza direct din tranzitiile pe clase; submultimea S<i> devine
+    // starea i + 1, ca 0 sa ramana starea moarta
+    CompiledAutomaton table(dfaStates + 1, 1, construction.classes);
+    for (const auto& transition : construction.transitions) {
+        table.setClassTransition(transition.from + 1, transition.byteClass, transition.to + 1);
+    }
+    for (uint32_t id = 0; id < dfaStates; ++id) {
+        table.setAccepting(id + 1, construction.sets[id].intersects(acceptingSet));
+    }
+    // Octetii deosebiti doar in AFN pot ajunge echivalenti in AFD
+    table.mergeEquivalentClasses();
+    return table;
+}
+
+DeterministicFiniteAutomaton LambdaNFA::toDFA(SubsetConstruction&& construction) const {
+    CompiledAutomaton table = compileConstruction(construction);
+    const uint32_t count = getStateCount();
+
+    // Numele lizibile ale submultimilor se genereaza doar la afisare
+    auto origin = std::make_shared<SubsetOrigin>();
+    origin->nfaStateNames.reserve(count);
+    for (uint32_t state = 0; state < count; ++state) {
+        origin->nfaStateNames.push_back(getStateName(state));
+    }
+    origin->subsets = std::move(construction.sets);
+
+    DeterministicFiniteAutomaton dfa(std::move(table), alphabet, "S");
+    dfa.setSubsetOrigin(std::move(origin));
+    return dfa;
+}
+
+void PrintLimitsExceeded(const std::string& what, const DeterminizeLimits& limits) {
+    std::cerr << "Eroare: AFD-ul pentru " << what << " depaseste limitele (";
+    if (limits.maxStates) std::cerr << limits.maxStates << " stari";
+    else std::cerr << "stari nelimitate";
+    if (limits.maxBytes) std::cerr << ", " << limits.maxBytes << " octeti";
+    std::cerr << ").\n";
+}
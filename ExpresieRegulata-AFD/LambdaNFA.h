@@ -0,0 +1,171 @@
+﻿#pragma once
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ByteClasses.h"
+#include "CompiledAutomaton.h"
+#include "RegexParser.h"
+#include "StateSet.h"
+
+class DeterministicFiniteAutomaton;
+
+// Rezultatul constructiei submultimilor: starea 0 este inchiderea starii initiale.
+// Tranzitiile sunt pe clase de octeti; o tranzitie exista pentru fiecare octet al clasei.
+struct SubsetConstruction {
+    struct Transition {
+        uint32_t from;
+        uint8_t byteClass;
+        uint32_t to;
+    };
+
+    ByteClasses classes;
+    std::vector<StateSet> sets;
+    std::vector<Transition> transitions;
+};
+
+// Limite pentru drumul AFN -> AFD minimal; 0 inseamna fara limita
+struct DeterminizeLimits {
+    size_t maxStates = 0;
+    // Memoria estimata a intregului drum: inchiderile λ, multimile de stari si
+    // tranzitiile, tabelul compilat si tablourile minimizarii
+    size_t maxBytes = 0;
+
+    // Bugetul implicit al bibliotecii si al liniei de comanda, ca la RegexEngine::Options
+    static DeterminizeLimits standard() { return { 1 << 16, 64 << 20 }; }
+};
+
+// "Eroare: AFD-ul pentru <what> depaseste limitele ..." la stderr
+void PrintLimitsExceeded(const std::string& what, const DeterminizeLimits& limits);
+
+// AFN cu λ-tranzitii cu stari numerotate 0..n-1. Tranzitiile sunt tinute
+// compact (offset per stare + vector comun), cate o lista pentru simboluri si
+// una pentru λ, deci o stare poate avea oricate λ-tranzitii. O muchie cu simbol
+// acopera un interval de octeti, deci o clasa ca [a-z0-9] are doua muchii.
+class LambdaNFA {
+public:
+    struct Edge {
+        unsigned char symbol;
+        uint32_t target;
+    };
+
+    // Muchie pe intervalul de octeti [low, high]
+    struct RangeEdge {
+        unsigned char low;
+        unsigned char high;
+        uint32_t target;
+    };
+
+    template <typename T>
+    struct Range {
+        const T* first;
+        const T* last;
+        const T* begin() const { return first; }
+        const T* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
+    // Muchiile pe clase de octeti, fara duplicate: in Edge::symbol este clasa
+    struct ClassEdges {
+        std::vector<uint32_t> start;
+        std::vector<Edge> edges;
+        Range<Edge> get(uint32_t state) const {
+            return { edges.data() + start[state], edges.data() + start[state + 1] };
+        }
+    };
+
+    // O singura stare, nefinala: limbajul vid
+    LambdaNFA();
+
+    // Numeroteaza starile unui automat cu nume de tip string; '\0' inseamna λ
+    static LambdaNFA fromAutomaton(const DeterministicFiniteAutomaton& automaton);
+    // Starile tabelului, cu aceleasi numere; starea moarta 0 ramane fara muchii
+    static LambdaNFA fromAutomaton(const CompiledAutomaton& automaton);
+
+    // Expresie regulata -> arbore sintactic -> AFN; fals daca expresia e invalida,
+    // cu eroarea afisata sau intoarsa in `error`
+    static bool fromExpression(const std::string& expression, LambdaNFA& result, RegexError* error = nullptr);
+
+    uint32_t getStateCount() const { return static_cast<uint32_t>(accepting.size()); }
+    uint32_t getInitialState() const { return initialState; }
+    bool isAccepting(uint32_t state) const { return accepting[state] != 0; }
+    // Indexul tiparului caruia ii apartine o stare finala (vezi combine)
+    uint32_t getAcceptTag(uint32_t state) const { return acceptTags[state]; }
+    Range<RangeEdge> getEdges(uint32_t state) const {
+        return { edges.data() + edgeStart[state], edges.data() + edgeStart[state + 1] };
+    }
+    Range<uint32_t> getLambdaEdges(uint32_t state) const {
+        return { lambdaEdges.data() + lambdaStart[state], lambdaEdges.data() + lambdaStart[state + 1] };
+    }
+    size_t getEdgeCount() const { return edges.size(); }
+    size_t getLambdaEdgeCount() const { return lambdaEdges.size(); }
+    const std::set<char>& getAlphabet() const { return alphabet; }
+    // Numele original al starii, sau q<i> pentru automatele construite direct
+    std::string getStateName(uint32_t state) const;
+
+    // AFN pentru limbajul oglindit: tranzitiile sunt inversate, iar noua stare
+    // initiala are λ-tranzitii spre vechile stari finale
+    LambdaNFA reversed() const;
+
+    // AFN pentru Σ*·L: o stare initiala noua cu bucla pe toti cei 256 de octeti
+    LambdaNFA unanchored() const;
+
+    // Reuneste mai multe AFN sub o stare initiala comuna; starile finale ale
+    // automatului i primesc eticheta i
+    static LambdaNFA combine(const std::vector<LambdaNFA>& nfas);
+
+    // Inchiderile lambda ale tuturor starilor, ca bitseturi
+    std::vector<StateSet> computeLambdaClosures() const;
+
+    // Doi octeti sunt echivalenti daca au exact aceleasi muchii (sursa, destinatie)
+    ByteClasses computeByteClasses() const;
+    ClassEdges computeClassEdges(const ByteClasses& classes) const;
+
+    // Constructia submultimilor cu multimi de stari ca bitseturi si internare prin hash.
+    // threadCount != 1 trece la determinizeParallel (0 = toate nucleele); rezultatul
+    // este acelasi indiferent de numarul de fire.
+    SubsetConstruction determinize(unsigned threadCount = 1) const;
+    // Varianta secventiala cu limite: se opreste si intoarce fals de indata ce
+    // AFD-ul depaseste numarul de stari sau memoria permisa. Memoria tabelului
+    // compilat si a minimizarii se socoteste deja aici, per stare AFD.
+    bool determinize(const DeterminizeLimits& limits, SubsetConstruction& result) const;
+    DeterministicFiniteAutomaton toDFA(unsigned threadCount = 1) const;
+    // Forma cu nume, cu limite; fals daca determinizarea le depaseste
+    bool toDFA(const DeterminizeLimits& limits, DeterministicFiniteAutomaton& result) const;
+    // AFD minimal direct ca tabel, fara forma cu nume; fals daca determinizarea
+    // depaseste limitele, caz in care `result` ramane neschimbat
+    bool toMinimalAutomaton(const DeterminizeLimits& limits, CompiledAutomaton& result) const;
+
+private:
+    friend LambdaNFA buildLambdaNFA(const RegexAst& ast);
+
+    using SymbolEdge = std::pair<uint32_t, RangeEdge>;
+    using LambdaEdge = std::pair<uint32_t, uint32_t>;
+
+    // Aseaza muchiile in forma compacta, stabil, prin sortare prin numarare
+    void assignEdges(const std::vector<SymbolEdge>& symbolEdges, const std::vector<LambdaEdge>& lambdaPairs);
+    void collectEdges(std::vector<SymbolEdge>& symbolEdges, std::vector<LambdaEdge>& lambdaPairs,
+        uint32_t offset = 0) const;
+    DeterministicFiniteAutomaton toDFA(SubsetConstruction&& construction) const;
+    CompiledAutomaton compileConstruction(const SubsetConstruction& construction) const;
+
+    uint32_t initialState;
+    std::vector<uint8_t> accepting;
+    std::vector<uint32_t> acceptTags;
+    std::vector<uint32_t> edgeStart;
+    std::vector<RangeEdge> edges;
+    std::vector<uint32_t> lambdaStart;
+    std::vector<uint32_t> lambdaEdges;
+    std::set<char> alphabet;
+    std::vector<std::string> names; // gol daca starile nu au nume proprii
+};
+
+// Construieste AFN cu λ-tranzitii din arborele sintactic (constructia Thompson).
+// O clasa de octeti devine o singura stare; {m,n} copiaza operandul.
+// Timp si memorie liniare in marimea arborelui dupa expandarea repetarilor.
+LambdaNFA buildLambdaNFA(const RegexAst& ast);
+
+// Acelasi AFN din forma poloneza (vezi RegexAst::fromPolishNotation)
+LambdaNFA buildLambdaNFA(const std::string& polishExpression);
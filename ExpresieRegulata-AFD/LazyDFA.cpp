@@ -0,0 +1,180 @@
+﻿#include "LazyDFA.h"
+#include "PipelineStats.h"
+#include <algorithm>
+
+size_t LazyDFA::KeyHash::operator()(uint32_t index) const {
+    uint64_t h = 1469598103934665603ull;
+    for (uint32_t state : (*keys)[index]) {
+        h ^= state;
+        h *= 1099511628211ull;
+    }
+    return static_cast<size_t>(h ^ (h >> 32));
+}
+
+LazyDFA::LazyDFA(LambdaNFA nfa)
+    : LazyDFA(std::move(nfa), Options()) {
+}
+
+LazyDFA::LazyDFA(LambdaNFA nfa, const Options& options)
+    : nfa(std::move(nfa)), options(options),
+    interned(16, KeyHash{ &keys }, KeyEqual{ &keys }) {
+    classes = this->nfa.computeByteClasses();
+    classEdges = this->nfa.computeClassEdges(classes);
+    scratch.resize(this->nfa.getStateCount());
+    other.resize(this->nfa.getStateCount());
+}
+
+size_t LazyDFA::stateCost(size_t keySize) const {
+    // Randul de tranzitii (o intrare pe clasa), cheia si o estimare pentru nodul din tabela de hash
+    return classes.getClassCount() * sizeof(uint32_t) + keySize * sizeof(uint32_t) + sizeof(std::vector<uint32_t>) + 32;
+}
+
+void LazyDFA::addClosure(SparseSet& set, uint32_t state) {
+    if (!set.insert(state)) return;
+    pending.push_back(state);
+    while (!pending.empty()) {
+        uint32_t current = pending.back();
+        pending.pop_back();
+        for (uint32_t target : nfa.getLambdaEdges(current)) {
+            if (set.insert(target)) pending.push_back(target);
+        }
+    }
+}
+
+void LazyDFA::stepNFA(const SparseSet& current, uint32_t byteClass, SparseSet& result) {
+    result.clear();
+    for (uint32_t state : current) {
+        for (const auto& edge : classEdges.get(state)) {
+            if (edge.symbol == byteClass) addClosure(result, edge.target);
+        }
+    }
+}
+
+bool LazyDFA::anyAccepting(const SparseSet& set) const {
+    for (uint32_t state : set) {
+        if (nfa.isAccepting(state)) return true;
+    }
+    return false;
+}
+
+void LazyDFA::flushCache() {
+    interned.clear();
+    keys.clear();
+    accepting.clear();
+    next.clear();
+    cachedStart = kUnknown;
+    cacheMemory = 0;
+    ++stats.cacheFlushes;
+
+    // Prea putini octeti consumati pentru starile create: cache-ul nu ajuta
+    if (bytesSinceFlush < options.minBytesPerState * statesSinceFlush) {
+        thrashing = true;
+    }
+    bytesSinceFlush = 0;
+    statesSinceFlush = 0;
+}
+
+uint32_t LazyDFA::internCurrent() {
+    if (scratch.empty()) return kDead;
+
+    std::vector<uint32_t> key(scratch.begin(), scratch.end());
+    std::sort(key.begin(), key.end());
+
+    keys.push_back(std::move(key));
+    uint32_t candidate = static_cast<uint32_t>(keys.size() - 1);
+    auto found = interned.find(candidate);
+    if (found != interned.end()) {
+        keys.pop_back();
+        return *found;
+    }
+
+    size_t cost = stateCost(keys.back().size());
+    if (cacheMemory + cost > options.memoryBudget && keys.size() > 1) {
+        std::vector<uint32_t> saved = std::move(keys.back());
+        keys.pop_back();
+        flushCache();
+        keys.push_back(std::move(saved));
+        candidate = 0;
+    }
+
+    interned.insert(candidate);
+    accepting.push_back(anyAccepting(scratch) ? 1 : 0);
+    next.resize(next.size() + classes.getClassCount(), kUnknown);
+    cacheMemory += cost;
+    ++statesSinceFlush;
+    return candidate;
+}
+
+uint32_t LazyDFA::startState() {
+    if (cachedStart == kUnknown) {
+        scratch.clear();
+        addClosure(scratch, nfa.getInitialState());
+        cachedStart = internCurrent();
+    }
+    return cachedStart;
+}
+
+uint32_t LazyDFA::computeNext(uint32_t state, uint32_t byteClass) {
+    ++stats.cacheMisses;
+    REGEX_AFD_RECORD(++pipeline.lazyCacheMisses);
+    other.clear();
+    for (uint32_t nfaState : keys[state]) other.insertNew(nfaState);
+    stepNFA(other, byteClass, scratch);
+
+    size_t flushesBefore = stats.cacheFlushes;
+    uint32_t target = internCurrent();
+    // Dupa o golire, starea sursa nu mai exista in cache
+    if (stats.cacheFlushes == flushesBefore) {
+        next[static_cast<size_t>(state) * classes.getClassCount() + byteClass] = target;
+    }
+    return target;
+}
+
+bool LazyDFA::simulateRest(std::string_view rest) {
+    ++stats.nfaFallbacks;
+    SparseSet* current = &other;
+    SparseSet* following = &scratch;
+    for (unsigned char symbol : rest) {
+        stepNFA(*current, classes.classOf(symbol), *following);
+        if (following->empty()) return false;
+        std::swap(current, following);
+    }
+    return anyAccepting(*current);
+}
+
+bool LazyDFA::CheckWord(std::string_view word) {
+    REGEX_AFD_STAGE(PipelineStage::Matching);
+    REGEX_AFD_RECORD(++pipeline.wordsMatched);
+    thrashing = false;
+    uint32_t state = startState();
+
+    for (size_t i = 0; i < word.size(); ++i) {
+        if (state == kDead) {
+            REGEX_AFD_RECORD(pipeline.bytesScanned += i; ++pipeline.deadStateExits);
+            return false;
+        }
+
+        uint32_t byteClass = classes.classOf(static_cast<unsigned char>(word[i]));
+        uint32_t target = next[static_cast<size_t>(state) * classes.getClassCount() + byteClass];
+        if (target == kUnknown) {
+            target = computeNext(state, byteClass);
+            if (thrashing) {
+                // Restul cuvantului se simuleaza pe AFN, pornind din multimea curenta
+                REGEX_AFD_RECORD(pipeline.bytesScanned += target == kDead ? i + 1 : word.size());
+                if (target == kDead) return false;
+                other.clear();
+                for (uint32_t nfaState : keys[target]) other.insertNew(nfaState);
+                return simulateRest(word.substr(i + 1));
+            }
+        }
+        else {
+            ++stats.cacheHits;
+            REGEX_AFD_RECORD(++pipeline.lazyCacheHits);
+        }
+        ++bytesSinceFlush;
+        state = target;
+    }
+
+    REGEX_AFD_RECORD(pipeline.bytesScanned += word.size(); pipeline.deadStateExits += state == kDead);
+    return state != kDead && accepting[state] != 0;
+}
@@ -0,0 +1,81 @@
+﻿#pragma once
+#include <cstdint>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "LambdaNFA.h"
+#include "SparseSet.h"
+
+// AFD construit la cerere din AFN: o stare apare doar cand intrarea ajunge in ea
+// si este pastrata intr-un cache limitat, golit complet cand se umple.
+// Daca cache-ul se goleste prea des, potrivirea continua prin simularea AFN.
+// Obiectul isi modifica cache-ul la fiecare potrivire, deci nu e thread-safe.
+class LazyDFA {
+public:
+    struct Options {
+        size_t memoryBudget = 1 << 20; // octeti pentru starile din cache
+        // Sub atatia octeti consumati per stare creata intre doua goliri, cache-ul e considerat inutil
+        size_t minBytesPerState = 10;
+    };
+
+    struct Stats {
+        uint64_t cacheHits = 0;
+        uint64_t cacheMisses = 0;
+        uint64_t cacheFlushes = 0;
+        uint64_t nfaFallbacks = 0;
+    };
+
+    explicit LazyDFA(LambdaNFA nfa);
+    LazyDFA(LambdaNFA nfa, const Options& options);
+
+    bool CheckWord(std::string_view word);
+
+    const Stats& getStats() const { return stats; }
+    size_t getCachedStateCount() const { return keys.size(); }
+    size_t getCacheMemory() const { return cacheMemory; }
+
+private:
+    static constexpr uint32_t kUnknown = UINT32_MAX;
+    static constexpr uint32_t kDead = UINT32_MAX - 1;
+
+    struct KeyHash {
+        const std::vector<std::vector<uint32_t>>* keys;
+        size_t operator()(uint32_t index) const;
+    };
+    struct KeyEqual {
+        const std::vector<std::vector<uint32_t>>* keys;
+        bool operator()(uint32_t a, uint32_t b) const { return (*keys)[a] == (*keys)[b]; }
+    };
+
+    void addClosure(SparseSet& set, uint32_t state);
+    void stepNFA(const SparseSet& current, uint32_t byteClass, SparseSet& next);
+    bool anyAccepting(const SparseSet& set) const;
+    uint32_t internCurrent(); // interneaza multimea din `scratch`
+    uint32_t startState();
+    uint32_t computeNext(uint32_t state, uint32_t byteClass);
+    void flushCache();
+    bool simulateRest(std::string_view rest);
+    size_t stateCost(size_t keySize) const;
+
+    LambdaNFA nfa;
+    ByteClasses classes;
+    LambdaNFA::ClassEdges classEdges;
+    Options options;
+    Stats stats;
+
+    std::vector<std::vector<uint32_t>> keys; // multimile de stari AFN, sortate
+    std::vector<uint8_t> accepting;
+    std::vector<uint32_t> next;              // [stare][clasa], kUnknown daca nu e calculat
+    std::unordered_set<uint32_t, KeyHash, KeyEqual> interned;
+    uint32_t cachedStart = kUnknown;
+    size_t cacheMemory = 0;
+
+    // Pentru detectarea goliririlor repetate
+    uint64_t bytesSinceFlush = 0;
+    uint64_t statesSinceFlush = 0;
+    bool thrashing = false;
+
+    SparseSet scratch;
+    SparseSet other;
+    std::vector<uint32_t> pending;
+};
@@ -0,0 +1,59 @@
+﻿#include "MappedFile.h"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::shared_ptr<const MappedFile> MappedFile::open(const std::string& path) {
+    std::shared_ptr<MappedFile> file(new MappedFile());
+
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return nullptr;
+    file->fileHandle = handle;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) return nullptr;
+    file->length = static_cast<size_t>(size.QuadPart);
+
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) return nullptr;
+    file->mappingHandle = mapping;
+
+    file->bytes = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!file->bytes) return nullptr;
+#else
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) return nullptr;
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || info.st_size == 0) {
+        ::close(descriptor);
+        return nullptr;
+    }
+    file->length = static_cast<size_t>(info.st_size);
+
+    void* address = mmap(nullptr, file->length, PROT_READ, MAP_SHARED, descriptor, 0);
+    ::close(descriptor); // maparea ramane valida si dupa inchiderea descriptorului
+    if (address == MAP_FAILED) return nullptr;
+    file->bytes = static_cast<const unsigned char*>(address);
+#endif
+
+    return file;
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+#else
+    if (bytes) munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+}
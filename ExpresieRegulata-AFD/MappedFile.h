@@ -0,0 +1,29 @@
+﻿#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Fisier mapat read-only in memorie (mmap / MapViewOfFile).
+// Paginile sunt partajate intre toate procesele care mapeaza acelasi fisier.
+class MappedFile {
+public:
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // nullptr daca fisierul nu poate fi deschis sau mapat
+    static std::shared_ptr<const MappedFile> open(const std::string& path);
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    MappedFile() = default;
+
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
@@ -0,0 +1,113 @@
+﻿#include "NFAMatcher.h"
+#include "PipelineStats.h"
+#include <utility>
+
+namespace {
+
+thread_local NFAMatcher::Scratch threadScratch;
+
+}
+
+NFAMatcher::NFAMatcher() : NFAMatcher(LambdaNFA()) {
+}
+
+NFAMatcher::NFAMatcher(LambdaNFA automaton)
+    : nfa(std::move(automaton)), startAccepting(false) {
+    classes = nfa.computeByteClasses();
+    classEdges = nfa.computeClassEdges(classes);
+
+    SparseSet start(nfa.getStateCount());
+    std::vector<uint32_t> pending;
+    addClosure(start, nfa.getInitialState(), pending);
+    startClosure.assign(start.begin(), start.end());
+    startAccepting = anyAccepting(start);
+}
+
+void NFAMatcher::addClosure(SparseSet& set, uint32_t state, std::vector<uint32_t>& pending) const {
+    if (!set.insert(state)) return;
+    pending.push_back(state);
+    while (!pending.empty()) {
+        uint32_t current = pending.back();
+        pending.pop_back();
+        for (uint32_t target : nfa.getLambdaEdges(current)) {
+            if (set.insert(target)) pending.push_back(target);
+        }
+    }
+}
+
+void NFAMatcher::step(const SparseSet& current, uint32_t byteClass, SparseSet& next,
+    std::vector<uint32_t>& pending) const {
+    next.clear();
+    for (uint32_t state : current) {
+        // Muchiile sunt sortate dupa clasa
+        for (const auto& edge : classEdges.get(state)) {
+            if (edge.symbol > byteClass) break;
+            if (edge.symbol == byteClass) addClosure(next, edge.target, pending);
+        }
+    }
+}
+
+void NFAMatcher::prepare(Scratch& scratch) const {
+    const uint32_t count = nfa.getStateCount();
+    if (scratch.first.capacity() < count) scratch.first.resize(count);
+    if (scratch.second.capacity() < count) scratch.second.resize(count);
+    scratch.first.clear();
+    scratch.second.clear();
+}
+
+bool NFAMatcher::anyAccepting(const SparseSet& set) const {
+    for (uint32_t state : set) {
+        if (nfa.isAccepting(state)) return true;
+    }
+    return false;
+}
+
+bool NFAMatcher::CheckWord(std::string_view word) const {
+    return CheckWord(word, threadScratch);
+}
+
+bool NFAMatcher::CheckWord(std::string_view word, Scratch& scratch) const {
+    REGEX_AFD_STAGE(PipelineStage::Matching);
+    prepare(scratch);
+    SparseSet* current = &scratch.first;
+    SparseSet* following = &scratch.second;
+    std::vector<uint32_t>& pending = scratch.pending;
+    for (uint32_t state : startClosure) current->insertNew(state);
+
+    for (size_t i = 0; i < word.size(); ++i) {
+        step(*current, classes.classOf(static_cast<unsigned char>(word[i])), *following, pending);
+        if (following->empty()) {
+            REGEX_AFD_RECORD(++pipeline.wordsMatched; pipeline.bytesScanned += i + 1; ++pipeline.deadStateExits);
+            return false;
+        }
+        std::swap(current, following);
+    }
+    REGEX_AFD_RECORD(++pipeline.wordsMatched; pipeline.bytesScanned += word.size());
+    return anyAccepting(*current);
+}
+
+bool NFAMatcher::search(std::string_view text) const {
+    return search(text, threadScratch);
+}
+
+bool NFAMatcher::search(std::string_view text, Scratch& scratch) const {
+    REGEX_AFD_STAGE(PipelineStage::Matching);
+    if (startAccepting) return true;
+
+    prepare(scratch);
+    SparseSet* current = &scratch.first;
+    SparseSet* following = &scratch.second;
+    std::vector<uint32_t>& pending = scratch.pending;
+    for (size_t i = 0; i < text.size(); ++i) {
+        // O potrivire poate incepe la fiecare pozitie
+        for (uint32_t state : startClosure) current->insert(state);
+        step(*current, classes.classOf(static_cast<unsigned char>(text[i])), *following, pending);
+        if (anyAccepting(*following)) {
+            REGEX_AFD_RECORD(++pipeline.wordsMatched; pipeline.bytesScanned += i + 1);
+            return true;
+        }
+        std::swap(current, following);
+    }
+    REGEX_AFD_RECORD(++pipeline.wordsMatched; pipeline.bytesScanned += text.size());
+    return false;
+}
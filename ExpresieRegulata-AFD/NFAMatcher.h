@@ -0,0 +1,50 @@
+﻿#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "LambdaNFA.h"
+#include "SparseSet.h"
+
+// Simularea AFN Thompson fara determinizare: multimea starilor active este un
+// SparseSet, iar un pas costa O(stari + muchii), indiferent cat de mare ar fi
+// AFD-ul echivalent. Folosita cand constructia submultimilor depaseste bugetul.
+//
+// Inchiderile λ se parcurg la fiecare pas (ca in LazyDFA) in loc sa fie
+// precalculate per stare: listele precalculate cresc patratic pe lanturi de
+// stelari, exact tiparele pentru care se ajunge aici. Doar inchiderea starii
+// initiale, folosita la fiecare pozitie de cautare, e pastrata.
+// Obiectul nu se modifica la potrivire, deci poate fi folosit din mai multe fire.
+class NFAMatcher {
+public:
+    // Multimile de lucru ale simularii. Variantele fara Scratch folosesc una per fir,
+    // care doar creste, deci apelurile repetate nu mai aloca O(stari) de fiecare data.
+    struct Scratch {
+        SparseSet first;
+        SparseSet second;
+        std::vector<uint32_t> pending;
+    };
+
+    // Limbajul vid
+    NFAMatcher();
+    explicit NFAMatcher(LambdaNFA nfa);
+
+    bool CheckWord(std::string_view word) const;
+    bool CheckWord(std::string_view word, Scratch& scratch) const;
+    // Adevarat daca un subsir al textului (eventual vid) este in limbaj
+    bool search(std::string_view text) const;
+    bool search(std::string_view text, Scratch& scratch) const;
+
+    uint32_t getStateCount() const { return nfa.getStateCount(); }
+
+private:
+    void prepare(Scratch& scratch) const;
+    void addClosure(SparseSet& set, uint32_t state, std::vector<uint32_t>& pending) const;
+    void step(const SparseSet& current, uint32_t byteClass, SparseSet& next, std::vector<uint32_t>& pending) const;
+    bool anyAccepting(const SparseSet& set) const;
+
+    LambdaNFA nfa;
+    ByteClasses classes;
+    LambdaNFA::ClassEdges classEdges;
+    std::vector<uint32_t> startClosure;
+    bool startAccepting;
+};
@@ -0,0 +1,203 @@
+﻿#include "ParallelSubsetConstruction.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+struct WorkItem {
+    uint32_t id;
+    StateSet set;
+};
+
+// Coada unui fir: proprietarul lucreaza la capatul din spate (LIFO, multimi
+// inca in cache), hotii iau din fata
+class WorkQueue {
+public:
+    void push(WorkItem&& item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        items.push_back(std::move(item));
+    }
+
+    bool pop(WorkItem& item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items.empty()) return false;
+        item = std::move(items.back());
+        items.pop_back();
+        return true;
+    }
+
+    bool steal(WorkItem& item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items.empty()) return false;
+        item = std::move(items.front());
+        items.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::deque<WorkItem> items;
+};
+
+// Tabela de internare: segmentul se alege din hash, deci firele se blocheaza
+// reciproc doar cand ating acelasi segment
+class ConcurrentSetTable {
+public:
+    static constexpr size_t kShardCount = 64;
+
+    // Intoarce indexul multimii si daca a fost adaugata acum
+    std::pair<uint32_t, bool> intern(const StateSet& set) {
+        const size_t hash = set.hash();
+        Shard& shard = shards[(hash >> 7) % kShardCount];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.ids.find(set);
+        if (it != shard.ids.end()) return { it->second, false };
+
+        uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+        shard.ids.emplace(set, id);
+        return { id, true };
+    }
+
+    uint32_t size() const { return nextId.load(); }
+
+    // Muta multimile intr-un vector indexat dupa id; apelat dupa ce firele s-au oprit
+    std::vector<StateSet> release() {
+        std::vector<StateSet> sets(size());
+        for (Shard& shard : shards) {
+            while (!shard.ids.empty()) {
+                auto node = shard.ids.extract(shard.ids.begin());
+                sets[node.mapped()] = std::move(node.key());
+            }
+        }
+        return sets;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<StateSet, uint32_t, StateSetHash> ids;
+    };
+
+    Shard shards[kShardCount];
+    std::atomic<uint32_t> nextId{ 0 };
+};
+
+}
+
+SubsetConstruction determinizeParallel(const LambdaNFA& nfa, unsigned threadCount) {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    const uint32_t count = nfa.getStateCount();
+    const std::vector<StateSet> closures = nfa.computeLambdaClosures();
+
+    const ByteClasses classes = nfa.computeByteClasses();
+    const LambdaNFA::ClassEdges classEdges = nfa.computeClassEdges(classes);
+    const uint32_t classCount = classes.getClassCount();
+
+    ConcurrentSetTable table;
+    std::vector<WorkQueue> queues(threadCount);
+    std::vector<std::vector<SubsetConstruction::Transition>> found(threadCount);
+    std::atomic<size_t> pending{ 1 }; // multimi descoperite dar neprocesate complet
+
+    table.intern(closures[nfa.getInitialState()]);
+    queues[0].push({ 0, closures[nfa.getInitialState()] });
+
+    auto worker = [&](unsigned self) {
+        std::vector<StateSet> successors(classCount, StateSet(count));
+        std::vector<uint32_t> touched;
+        std::vector<uint8_t> isTouched(classCount, 0);
+        std::vector<SubsetConstruction::Transition>& transitions = found[self];
+        WorkItem item;
+
+        while (true) {
+            bool haveWork = queues[self].pop(item);
+            for (unsigned k = 1; !haveWork && k < threadCount; ++k) {
+                haveWork = queues[(self + k) % threadCount].steal(item);
+            }
+            if (!haveWork) {
+                if (pending.load(std::memory_order_acquire) == 0) return;
+                std::this_thread::yield();
+                continue;
+            }
+
+            item.set.forEach([&](uint32_t state) {
+                for (const LambdaNFA::Edge& edge : classEdges.get(state)) {
+                    uint32_t index = edge.symbol;
+                    if (!isTouched[index]) {
+                        isTouched[index] = 1;
+                        touched.push_back(index);
+                    }
+                    successors[index].unite(closures[edge.target]);
+                }
+            });
+
+            for (uint32_t index : touched) {
+                auto [id, inserted] = table.intern(successors[index]);
+                if (inserted) {
+                    pending.fetch_add(1, std::memory_order_relaxed);
+                    queues[self].push({ id, successors[index] });
+                }
+                successors[index].clear();
+                isTouched[index] = 0;
+                transitions.push_back({ item.id, static_cast<uint8_t>(index), id });
+            }
+            touched.clear();
+            pending.fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; ++i) threads.emplace_back(worker, i);
+    worker(0);
+    for (auto& thread : threads) thread.join();
+
+    // Tranzitiile grupate pe starea sursa, in ordinea claselor
+    const uint32_t setCount = table.size();
+    std::vector<uint32_t> start(setCount + 1, 0);
+    for (const auto& transitions : found) {
+        for (const auto& transition : transitions) ++start[transition.from + 1];
+    }
+    for (uint32_t id = 0; id < setCount; ++id) start[id + 1] += start[id];
+    std::vector<SubsetConstruction::Transition> grouped(start.back());
+    std::vector<uint32_t> fill(start.begin(), start.end() - 1);
+    for (auto& transitions : found) {
+        for (const auto& transition : transitions) grouped[fill[transition.from]++] = transition;
+        std::vector<SubsetConstruction::Transition>().swap(transitions);
+    }
+    for (uint32_t id = 0; id < setCount; ++id) {
+        std::sort(grouped.begin() + start[id], grouped.begin() + start[id + 1],
+            [](const auto& a, const auto& b) { return a.byteClass < b.byteClass; });
+    }
+
+    // Renumerotare canonica: BFS din starea 0, succesorii in ordinea claselor
+    constexpr uint32_t kUnassigned = UINT32_MAX;
+    std::vector<uint32_t> canonical(setCount, kUnassigned);
+    std::vector<uint32_t> order;
+    order.reserve(setCount);
+    canonical[0] = 0;
+    order.push_back(0);
+
+    SubsetConstruction result;
+    result.classes = classes;
+    result.transitions.reserve(grouped.size());
+    for (size_t position = 0; position < order.size(); ++position) {
+        const uint32_t id = order[position];
+        for (uint32_t i = start[id]; i < start[id + 1]; ++i) {
+            const auto& transition = grouped[i];
+            if (canonical[transition.to] == kUnassigned) {
+                canonical[transition.to] = static_cast<uint32_t>(order.size());
+                order.push_back(transition.to);
+            }
+            result.transitions.push_back({ static_cast<uint32_t>(position), transition.byteClass, canonical[transition.to] });
+        }
+    }
+
+    std::vector<StateSet> sets = table.release();
+    result.sets.reserve(setCount);
+    for (uint32_t id : order) result.sets.push_back(std::move(sets[id]));
+    return result;
+}
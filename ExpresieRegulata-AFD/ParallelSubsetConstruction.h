@@ -0,0 +1,10 @@
+﻿#pragma once
+#include "LambdaNFA.h"
+
+// Constructia submultimilor pe mai multe fire. Fiecare fir are propria coada
+// de multimi neexplorate si fura de la celelalte cand ramane fara lucru; noile
+// multimi sunt internate intr-o tabela de hash impartita pe segmente cu mutex.
+// La final starile sunt renumerotate in ordinea BFS a variantei secventiale,
+// deci rezultatul este identic cu LambdaNFA::determinize().
+// threadCount = 0 foloseste numarul de nuclee disponibile.
+SubsetConstruction determinizeParallel(const LambdaNFA& nfa, unsigned threadCount);
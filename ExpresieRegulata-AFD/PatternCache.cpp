@@ -0,0 +1,196 @@
+﻿#include "PatternCache.h"
+#include "LambdaNFA.h"
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Memoria ocupata de tabel, bitmap si harta claselor
+size_t automatonBytes(const CompiledAutomaton& automaton) {
+    const size_t states = automaton.getStateCount();
+    return sizeof(CompiledAutomaton)
+        + states * automaton.getClassCount() * sizeof(uint32_t)
+        + (states + 63) / 64 * sizeof(uint64_t);
+}
+
+std::string hexHash(uint64_t hash) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+// Nume temporar unic intre procese (pid) si intre firele aceluiasi proces
+std::string temporaryPath(const std::string& path) {
+#ifdef _WIN32
+    const long processId = _getpid();
+#else
+    const long processId = static_cast<long>(getpid());
+#endif
+    const size_t threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+    return path + "." + std::to_string(processId) + "." + std::to_string(threadId) + ".tmp";
+}
+
+// Inlocuieste `to` daca exista deja; pe Windows std::rename esueaza in acest caz
+bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+void reportLimitsExceeded(const std::string& expression, const DeterminizeLimits& limits, RegexError* error) {
+    if (error) *error = RegexError{ 0, "automatul depaseste limitele de determinizare" };
+    else PrintLimitsExceeded(expression, limits);
+}
+
+}
+
+PatternCache::PatternCache(size_t capacityBytes, std::string directory)
+    : capacityBytes(capacityBytes), directory(std::move(directory)) {
+}
+
+PatternCache::Handle PatternCache::get(const std::string& expression) {
+    return get(expression, CompileOptions());
+}
+
+PatternCache::Handle PatternCache::get(const std::string& expression, const CompileOptions& options,
+    RegexError* error) {
+    RegexAst ast;
+    RegexError parseError;
+    if (!RegexAst::parse(expression, ast, &parseError)) {
+        if (error) *error = parseError;
+        else PrintRegexError(expression, parseError);
+        return nullptr;
+    }
+    const std::string key = (options.unanchored ? "u:" : "a:") + ast.toString();
+
+    std::promise<Handle> promise;
+    std::shared_future<Handle> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = entries.find(key);
+        if (found != entries.end()) {
+            ++stats.hits;
+            lru.splice(lru.begin(), lru, found->second);
+            return found->second->automaton;
+        }
+        auto flight = inFlight.find(key);
+        if (flight != inFlight.end()) {
+            ++stats.coalesced;
+            pending = flight->second;
+        }
+        else {
+            ++stats.misses;
+            inFlight.emplace(key, promise.get_future().share());
+        }
+    }
+    if (pending.valid()) {
+        Handle automaton = pending.get();
+        if (!automaton) reportLimitsExceeded(expression, options.limits, error);
+        return automaton;
+    }
+
+    Handle automaton;
+    try {
+        automaton = compile(ast, options, key);
+    }
+    catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight.erase(key);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        inFlight.erase(key);
+        if (automaton) insert(key, automaton);
+    }
+    promise.set_value(automaton);
+    if (!automaton) reportLimitsExceeded(expression, options.limits, error);
+    return automaton;
+}
+
+PatternCache::Handle PatternCache::compile(const RegexAst& ast, const CompileOptions& options,
+    const std::string& key) {
+    const uint64_t keyHash = HashBytes(key.data(), key.size());
+    std::string path;
+    if (!directory.empty()) {
+        path = directory + "/" + hexHash(keyHash) + ".afd";
+        std::ifstream existing(path, std::ios::binary);
+        if (existing.is_open()) {
+            existing.close();
+            // Numele fisierului e doar hash-ul cheii; la o coliziune cheia salvata
+            // difera, iar automatul se recompileaza
+            auto loaded = std::make_shared<CompiledAutomaton>();
+            std::string storedKey;
+            if (CompiledAutomaton::loadFromFile(path, *loaded, true, nullptr, &storedKey) && storedKey == key) {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++stats.diskLoads;
+                return loaded;
+            }
+        }
+    }
+
+    LambdaNFA nfa = buildLambdaNFA(ast);
+    if (options.unanchored) {
+        nfa = nfa.unanchored();
+    }
+    auto automaton = std::make_shared<CompiledAutomaton>();
+    if (!nfa.toMinimalAutomaton(options.limits, *automaton)) {
+        return nullptr;
+    }
+
+    if (!path.empty()) {
+        // Scris sub alt nume si redenumit, ca alte procese sa nu vada un fisier incomplet
+        const std::string temporary = temporaryPath(path);
+        if (!automaton->saveToFile(temporary, keyHash, key) || !replaceFile(temporary, path)) {
+            std::remove(temporary.c_str());
+        }
+    }
+    return automaton;
+}
+
+void PatternCache::insert(const std::string& key, const Handle& automaton) {
+    const size_t bytes = automatonBytes(*automaton) + key.size();
+    if (bytes > capacityBytes) {
+        return; // nu ar incapea nici singur; apelantul il foloseste necache-uit
+    }
+
+    while (stats.bytes + bytes > capacityBytes) {
+        const Entry& oldest = lru.back();
+        stats.bytes -= oldest.bytes;
+        entries.erase(oldest.key);
+        lru.pop_back();
+        ++stats.evictions;
+    }
+
+    lru.push_front({ key, automaton, bytes });
+    entries.emplace(key, lru.begin());
+    stats.bytes += bytes;
+    stats.entries = entries.size();
+}
+
+PatternCache::Stats PatternCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void PatternCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.clear();
+    entries.clear();
+    stats.bytes = 0;
+    stats.entries = 0;
+}
@@ -0,0 +1,80 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "CompiledAutomaton.h"
+#include "LambdaNFA.h"
+#include "RegexParser.h"
+
+// Cache de automate compilate, partajat intre fire. Cheia este forma
+// normalizata a expresiei (RegexAst::toString, deci "(a)b" si "ab" dau aceeasi
+// intrare) impreuna cu optiunile de compilare. Intrarile sunt eliminate in
+// ordinea LRU cand totalul octetilor depaseste capacitatea.
+//
+// Automatele sunt imutabile si se impart prin shared_ptr: o intrare eliminata
+// ramane valida cat timp cineva o mai foloseste. Daca mai multe fire cer
+// aceeasi cheie inainte sa fie compilata, doar primul compileaza, iar
+// celelalte asteapta rezultatul lui.
+//
+// Cu un director, automatele se salveaza si ca fisiere .afd si sunt mapate de
+// acolo la urmatoarea ratare (de exemplu dupa repornirea procesului). Fisierul
+// poarta cheia normalizata, comparata la incarcare.
+class PatternCache {
+public:
+    using Handle = std::shared_ptr<const CompiledAutomaton>;
+
+    struct CompileOptions {
+        // Automatul lui Σ*·L (LambdaNFA::unanchored), pentru StreamMatcher::Mode::Search
+        bool unanchored = false;
+        // Bugetul determinizarii; nu face parte din cheie, automatul fiind acelasi
+        DeterminizeLimits limits = DeterminizeLimits::standard();
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;      // compilari (sau incarcari de pe disc) pornite
+        uint64_t coalesced = 0;   // cereri care au asteptat compilarea altui fir
+        uint64_t evictions = 0;
+        uint64_t diskLoads = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    explicit PatternCache(size_t capacityBytes = 64 << 20, std::string directory = std::string());
+    PatternCache(const PatternCache&) = delete;
+    PatternCache& operator=(const PatternCache&) = delete;
+
+    // nullptr daca expresia e invalida sau AFD-ul depaseste options.limits; detaliile
+    // ajung in `error`, daca e dat, altfel sunt afisate
+    Handle get(const std::string& expression);
+    Handle get(const std::string& expression, const CompileOptions& options, RegexError* error = nullptr);
+
+    Stats getStats() const;
+    size_t getCapacity() const { return capacityBytes; }
+    // Goleste memoria; fisierele din director raman
+    void clear();
+
+private:
+    struct Entry {
+        std::string key;
+        Handle automaton;
+        size_t bytes;
+    };
+
+    Handle compile(const RegexAst& ast, const CompileOptions& options, const std::string& key);
+    void insert(const std::string& key, const Handle& automaton);
+
+    const size_t capacityBytes;
+    const std::string directory;
+
+    mutable std::mutex mutex;
+    std::list<Entry> lru; // cel mai recent folosit in fata
+    std::unordered_map<std::string, std::list<Entry>::iterator> entries;
+    std::unordered_map<std::string, std::shared_future<Handle>> inFlight;
+    Stats stats;
+};
@@ -0,0 +1,100 @@
+﻿#include "PatternSet.h"
+#include "LambdaNFA.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+PatternSet::PatternSet() : matchStart(2, 0) {
+}
+
+bool PatternSet::fromFile(const std::string& path, PatternSet& result, const DeterminizeLimits& limits) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Fisierul nu a putut fi deschis: " << path << "\n";
+        return false;
+    }
+
+    std::vector<std::string> expressions;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) expressions.push_back(line);
+    }
+
+    return fromExpressions(expressions, result, limits);
+}
+
+bool PatternSet::fromExpressions(const std::vector<std::string>& expressions, PatternSet& result,
+    const DeterminizeLimits& limits) {
+    std::vector<LambdaNFA> nfas(expressions.size());
+    for (size_t i = 0; i < expressions.size(); ++i) {
+        if (!LambdaNFA::fromExpression(expressions[i], nfas[i])) {
+            std::cerr << "Eroare: Expresia " << i << " (" << expressions[i] << ") este invalida.\n";
+            return false;
+        }
+    }
+
+    if (!fromNFAs(nfas, limits, result)) {
+        PrintLimitsExceeded(std::to_string(expressions.size()) + " tipare", limits);
+        return false;
+    }
+    result.patterns = expressions;
+    return true;
+}
+
+bool PatternSet::fromNFAs(const std::vector<LambdaNFA>& nfas, const DeterminizeLimits& limits, PatternSet& result) {
+    const LambdaNFA combined = LambdaNFA::combine(nfas);
+    SubsetConstruction construction;
+    if (!combined.determinize(limits, construction)) {
+        return false;
+    }
+    const uint32_t dfaStates = static_cast<uint32_t>(construction.sets.size());
+
+    PatternSet set;
+    set.patterns.resize(nfas.size());
+
+    // Starile submultimilor se decaleaza cu 1, ca 0 sa ramana starea moarta
+    set.automaton = CompiledAutomaton(dfaStates + 1, 1, construction.classes);
+    for (const auto& transition : construction.transitions) {
+        set.automaton.setClassTransition(transition.from + 1, transition.byteClass, transition.to + 1);
+    }
+    // Octetii deosebiti doar in AFN pot ajunge echivalenti in AFD
+    set.automaton.mergeEquivalentClasses();
+
+    set.matchStart.assign(1, 0);
+    set.matchStart.push_back(0); // starea moarta nu accepta nimic
+    std::vector<uint32_t> ids;
+    for (uint32_t id = 0; id < dfaStates; ++id) {
+        ids.clear();
+        construction.sets[id].forEach([&](uint32_t state) {
+            if (combined.isAccepting(state)) ids.push_back(combined.getAcceptTag(state));
+        });
+        // Starile fiecarui tipar sunt contigue, deci etichetele vin deja crescator
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+        set.automaton.setAccepting(id + 1, !ids.empty());
+        set.matchIds.insert(set.matchIds.end(), ids.begin(), ids.end());
+        set.matchStart.push_back(static_cast<uint32_t>(set.matchIds.size()));
+    }
+
+    result = std::move(set);
+    return true;
+}
+
+uint32_t PatternSet::run(std::string_view word) const {
+    uint32_t state = automaton.getStartState();
+    for (unsigned char symbol : word) {
+        state = automaton.next(state, symbol);
+        if (state == CompiledAutomaton::kDeadState) break;
+    }
+    return state;
+}
+
+void PatternSet::match(std::string_view word, std::vector<uint32_t>& ids) const {
+    uint32_t state = run(word);
+    ids.assign(matchIds.begin() + matchStart[state], matchIds.begin() + matchStart[state + 1]);
+}
+
+bool PatternSet::matchesAny(std::string_view word) const {
+    return automaton.isAccepting(run(word));
+}
@@ -0,0 +1,41 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CompiledAutomaton.h"
+#include "LambdaNFA.h"
+
+// Multe expresii regulate compilate intr-un singur AFD. Fiecare stare finala
+// retine lista tiparelor acceptate, deci o singura trecere peste cuvant
+// raspunde pentru toate tiparele, indiferent cate sunt.
+class PatternSet {
+public:
+    PatternSet();
+
+    // Citeste cate o expresie pe linie; liniile goale sunt ignorate
+    static bool fromFile(const std::string& path, PatternSet& result,
+        const DeterminizeLimits& limits = DeterminizeLimits::standard());
+    // Fals daca o expresie e invalida sau AFD-ul combinat depaseste limitele
+    static bool fromExpressions(const std::vector<std::string>& expressions, PatternSet& result,
+        const DeterminizeLimits& limits = DeterminizeLimits::standard());
+    // Fals, fara mesaj, daca AFD-ul combinat depaseste limitele
+    static bool fromNFAs(const std::vector<LambdaNFA>& nfas, const DeterminizeLimits& limits, PatternSet& result);
+
+    size_t getPatternCount() const { return patterns.size(); }
+    const std::string& getPattern(uint32_t id) const { return patterns[id]; }
+    const CompiledAutomaton& getAutomaton() const { return automaton; }
+
+    // Scrie in `ids` indicii tiparelor care accepta cuvantul intreg, crescator
+    void match(std::string_view word, std::vector<uint32_t>& ids) const;
+    bool matchesAny(std::string_view word) const;
+
+private:
+    uint32_t run(std::string_view word) const;
+
+    std::vector<std::string> patterns;
+    CompiledAutomaton automaton;
+    // Tiparele acceptate in fiecare stare: matchIds[matchStart[s] .. matchStart[s + 1])
+    std::vector<uint32_t> matchStart;
+    std::vector<uint32_t> matchIds;
+};
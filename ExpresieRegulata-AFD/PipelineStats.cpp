@@ -0,0 +1,95 @@
+﻿#include "PipelineStats.h"
+#include <algorithm>
+
+namespace {
+
+thread_local PipelineStats* activeStats = nullptr;
+
+#if REGEX_AFD_STATS
+thread_local PipelineStageTimer* currentTimer = nullptr;
+thread_local PipelineStage currentStage = PipelineStage::Count;
+#endif
+
+}
+
+void PipelineStatsCountAllocation(size_t size) {
+#if REGEX_AFD_STATS
+    if (activeStats && currentStage != PipelineStage::Count) {
+        (*activeStats)[currentStage].bytesAllocated += size;
+    }
+#else
+    (void)size;
+#endif
+}
+
+PipelineStatsScope::PipelineStatsScope(PipelineStats& stats) : previous(activeStats) {
+#if REGEX_AFD_STATS
+    activeStats = &stats;
+#else
+    (void)stats;
+#endif
+}
+
+PipelineStatsScope::~PipelineStatsScope() {
+    activeStats = previous;
+}
+
+PipelineStats* PipelineStatsScope::active() {
+    return activeStats;
+}
+
+#if REGEX_AFD_STATS
+PipelineStageTimer::PipelineStageTimer(PipelineStage stage)
+    : stats(activeStats), stage(stage), parent(currentTimer), childNanoseconds(0) {
+    if (!stats) return;
+    currentTimer = this;
+    currentStage = stage;
+    start = std::chrono::steady_clock::now();
+}
+
+PipelineStageTimer::~PipelineStageTimer() {
+    if (!stats) return;
+    const uint64_t elapsed = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    PipelineStats::Stage& entry = (*stats)[stage];
+    ++entry.calls;
+    entry.nanoseconds += elapsed - std::min(elapsed, childNanoseconds);
+    if (parent) parent->childNanoseconds += elapsed;
+    currentTimer = parent;
+    currentStage = parent ? parent->stage : PipelineStage::Count;
+}
+#endif
+
+const char* PipelineStageName(PipelineStage stage) {
+    switch (stage) {
+    case PipelineStage::Parse: return "parse";
+    case PipelineStage::LambdaNFA: return "lambda_nfa";
+    case PipelineStage::LambdaClosure: return "lambda_closure";
+    case PipelineStage::SubsetConstruction: return "subset_construction";
+    case PipelineStage::Minimization: return "minimization";
+    case PipelineStage::Matching: return "matching";
+    default: return "unknown";
+    }
+}
+
+void WritePipelineStatsJson(const PipelineStats& stats, std::ostream& out) {
+    out << "{\n  \"enabled\": " << (REGEX_AFD_STATS ? "true" : "false") << ",\n  \"stages\": {\n";
+    for (size_t i = 0; i < static_cast<size_t>(PipelineStage::Count); ++i) {
+        const PipelineStats::Stage& stage = stats.stages[i];
+        out << "    \"" << PipelineStageName(static_cast<PipelineStage>(i)) << "\": {\"calls\": " << stage.calls
+            << ", \"ns\": " << stage.nanoseconds << ", \"bytes_allocated\": " << stage.bytesAllocated << "}"
+            << (i + 1 < static_cast<size_t>(PipelineStage::Count) ? "," : "") << "\n";
+    }
+    out << "  },\n";
+    out << "  \"nfa\": {\"states\": " << stats.nfaStates << ", \"transitions\": " << stats.nfaTransitions
+        << ", \"lambda_transitions\": " << stats.nfaLambdaTransitions << "},\n";
+    out << "  \"dfa\": {\"states\": " << stats.dfaStates << ", \"transitions\": " << stats.dfaTransitions << "},\n";
+    out << "  \"minimal_dfa\": {\"states\": " << stats.minimalStates << ", \"transitions\": "
+        << stats.minimalTransitions << "},\n";
+    out << "  \"peak\": {\"closure_size\": " << stats.peakClosureSize << ", \"subset_size\": "
+        << stats.peakSubsetSize << "},\n";
+    out << "  \"matching\": {\"words\": " << stats.wordsMatched << ", \"bytes_scanned\": " << stats.bytesScanned
+        << ", \"dead_state_exits\": " << stats.deadStateExits << ", \"lazy_cache_hits\": " << stats.lazyCacheHits
+        << ", \"lazy_cache_misses\": " << stats.lazyCacheMisses << "}\n";
+    out << "}\n";
+}
@@ -0,0 +1,119 @@
+﻿#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Instrumentarea optionala a pipeline-ului expresie -> AFN -> AFD -> potrivire.
+// Se activeaza la compilare cu REGEX_AFD_STATS=1 (optiunea CMake cu acelasi nume);
+// altfel REGEX_AFD_STAGE si REGEX_AFD_RECORD nu genereaza niciun cod, iar
+// PipelineStatsScope nu face nimic. Cand e activa, se colecteaza doar pe firul
+// care a deschis un PipelineStatsScope:
+//
+//   PipelineStats stats;
+//   {
+//       PipelineStatsScope scope(stats);
+//       ... constructie si potrivire ...
+//   }
+//   WritePipelineStatsJson(stats, std::cout);
+#ifndef REGEX_AFD_STATS
+#define REGEX_AFD_STATS 0
+#endif
+
+enum class PipelineStage {
+    Parse,              // RegexAst::parse, RegexAst::fromPolishNotation
+    LambdaNFA,          // buildLambdaNFA, LambdaNFA::fromAutomaton
+    LambdaClosure,      // λ-inchiderile, inclusiv calculateLambdaClosure
+    SubsetConstruction, // toDFA / convertToDFA
+    Minimization,
+    Matching,           // CheckWord, CheckWords, LazyDFA::CheckWord
+    Count
+};
+
+struct PipelineStats {
+    // Timpul unei etape nu include etapele apelate din ea; memoria alocata se
+    // atribuie etapei celei mai interioare
+    struct Stage {
+        uint64_t calls = 0;
+        uint64_t nanoseconds = 0;
+        uint64_t bytesAllocated = 0;
+    };
+    Stage stages[static_cast<size_t>(PipelineStage::Count)];
+
+    // Dimensiunile ultimelor automate construite
+    uint64_t nfaStates = 0;
+    uint64_t nfaTransitions = 0;
+    uint64_t nfaLambdaTransitions = 0;
+    uint64_t dfaStates = 0;
+    uint64_t dfaTransitions = 0; // pe clase de octeti
+    uint64_t minimalStates = 0;
+    uint64_t minimalTransitions = 0;
+    // Cele mai mari multimi intermediare
+    uint64_t peakClosureSize = 0; // λ-inchiderea unei stari AFN
+    uint64_t peakSubsetSize = 0;  // starile AFN dintr-o stare AFD
+
+    // Potrivire; CheckWords numara toti octetii cuvintelor, fara iesirile timpurii
+    uint64_t wordsMatched = 0;
+    uint64_t bytesScanned = 0;
+    uint64_t deadStateExits = 0;
+    uint64_t lazyCacheHits = 0;
+    uint64_t lazyCacheMisses = 0;
+
+    Stage& operator[](PipelineStage stage) { return stages[static_cast<size_t>(stage)]; }
+    const Stage& operator[](PipelineStage stage) const { return stages[static_cast<size_t>(stage)]; }
+};
+
+const char* PipelineStageName(PipelineStage stage);
+void WritePipelineStatsJson(const PipelineStats& stats, std::ostream& out);
+
+// Atribuie `size` octeti alocati etapei curente a firului. Biblioteca nu inlocuieste
+// operatorii globali; un executabil care vrea bytes_allocated compileaza
+// PipelineStatsAllocator.cpp, al carui operator new apeleaza aceasta functie.
+// Fara REGEX_AFD_STATS nu face nimic.
+void PipelineStatsCountAllocation(size_t size);
+
+// Directioneaza masuratorile firului curent in `stats` pana la distrugere
+class PipelineStatsScope {
+public:
+    explicit PipelineStatsScope(PipelineStats& stats);
+    ~PipelineStatsScope();
+    PipelineStatsScope(const PipelineStatsScope&) = delete;
+    PipelineStatsScope& operator=(const PipelineStatsScope&) = delete;
+
+    // nullptr daca firul curent nu colecteaza
+    static PipelineStats* active();
+
+private:
+    PipelineStats* previous;
+};
+
+#if REGEX_AFD_STATS
+// Masoara durata unei etape pana la sfarsitul blocului
+class PipelineStageTimer {
+public:
+    explicit PipelineStageTimer(PipelineStage stage);
+    ~PipelineStageTimer();
+    PipelineStageTimer(const PipelineStageTimer&) = delete;
+    PipelineStageTimer& operator=(const PipelineStageTimer&) = delete;
+
+private:
+    PipelineStats* stats;
+    PipelineStage stage;
+    PipelineStageTimer* parent;
+    uint64_t childNanoseconds;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define REGEX_AFD_STAGE(stage) PipelineStageTimer regexAfdStageTimer(stage)
+// Instructiunea primeste statisticile active ca `pipeline`
+#define REGEX_AFD_RECORD(statement) \
+    do { \
+        if (PipelineStats* regexAfdPipeline = PipelineStatsScope::active()) { \
+            PipelineStats& pipeline = *regexAfdPipeline; \
+            statement; \
+        } \
+    } while (0)
+#else
+#define REGEX_AFD_STAGE(stage) ((void)0)
+#define REGEX_AFD_RECORD(statement) ((void)0)
+#endif
@@ -0,0 +1,46 @@
+﻿// Inlocuirea operatorilor globali new/delete, pentru bytes_allocated din
+// statisticile pipeline-ului. Nu face parte din biblioteca: o compileaza doar
+// executabilul care o cere, ca programele care leaga regex_afd sa-si pastreze
+// propriul alocator. Fara REGEX_AFD_STATS fisierul nu defineste nimic.
+#include "PipelineStats.h"
+#include <cstdlib>
+#include <new>
+
+#if REGEX_AFD_STATS
+namespace {
+
+// Ca operatorul standard: la esec se apeleaza new_handler-ul instalat, pana
+// reuseste alocarea sau nu mai exista handler
+void* allocate(size_t size) {
+    PipelineStatsCountAllocation(size);
+    if (size == 0) size = 1;
+    for (;;) {
+        if (void* memory = std::malloc(size)) return memory;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* allocateNothrow(size_t size) noexcept {
+    try {
+        return allocate(size);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+}
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocateNothrow(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocateNothrow(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+#endif
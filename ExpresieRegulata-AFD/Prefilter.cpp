@@ -0,0 +1,262 @@
+﻿#include "Prefilter.h"
+#include "RegexParser.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stack>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PREFILTER_SSE2 1
+#endif
+
+namespace {
+
+std::string commonPrefix(const std::string& a, const std::string& b) {
+    size_t length = 0;
+    while (length < a.size() && length < b.size() && a[length] == b[length]) ++length;
+    return a.substr(0, length);
+}
+
+std::string commonSuffix(const std::string& a, const std::string& b) {
+    size_t length = 0;
+    while (length < a.size() && length < b.size() && a[a.size() - 1 - length] == b[b.size() - 1 - length]) ++length;
+    return a.substr(a.size() - length);
+}
+
+const std::string& longer(const std::string& a, const std::string& b) {
+    return b.size() > a.size() ? b : a;
+}
+
+LiteralInfo literal(char symbol) {
+    LiteralInfo info;
+    info.valid = true;
+    info.isExact = true;
+    info.exact = info.prefix = info.suffix = info.required = std::string(1, symbol);
+    info.firstBytes.set(static_cast<unsigned char>(symbol));
+    return info;
+}
+
+LiteralInfo concatenate(const LiteralInfo& a, const LiteralInfo& b) {
+    LiteralInfo info;
+    info.valid = true;
+    info.nullable = a.nullable && b.nullable;
+    info.isExact = a.isExact && b.isExact;
+    if (info.isExact) info.exact = a.exact + b.exact;
+
+    info.prefix = a.isExact ? a.exact + b.prefix : a.prefix;
+    info.suffix = b.isExact ? a.suffix + b.exact : b.suffix;
+
+    // Sufixul lui A lipit de prefixul lui B apare in orice cuvant din AB
+    info.required = longer(longer(a.required, b.required), a.suffix + b.prefix);
+    info.required = longer(info.required, longer(info.prefix, info.suffix));
+
+    info.firstBytes = a.nullable ? (a.firstBytes | b.firstBytes) : a.firstBytes;
+    return info;
+}
+
+LiteralInfo alternate(const LiteralInfo& a, const LiteralInfo& b) {
+    LiteralInfo info;
+    info.valid = true;
+    info.nullable = a.nullable || b.nullable;
+    info.isExact = a.isExact && b.isExact && a.exact == b.exact;
+    if (info.isExact) info.exact = a.exact;
+    info.prefix = commonPrefix(a.prefix, b.prefix);
+    info.suffix = commonSuffix(a.suffix, b.suffix);
+    if (a.required == b.required) info.required = a.required;
+    info.required = longer(info.required, longer(info.prefix, info.suffix));
+    info.firstBytes = a.firstBytes | b.firstBytes;
+    return info;
+}
+
+LiteralInfo star(const LiteralInfo& a) {
+    LiteralInfo info;
+    info.valid = true;
+    info.nullable = true;
+    info.firstBytes = a.firstBytes;
+    return info;
+}
+
+// Cuvantul vid: exact "", neutru la concatenare
+LiteralInfo empty() {
+    LiteralInfo info;
+    info.valid = true;
+    info.nullable = true;
+    info.isExact = true;
+    return info;
+}
+
+// O clasa cu mai multi octeti nu fixeaza niciun literal, doar primul octet
+LiteralInfo byteSet(const std::bitset<256>& bytes) {
+    if (bytes.count() == 1) {
+        for (unsigned value = 0; value < 256; ++value) {
+            if (bytes.test(value)) return literal(static_cast<char>(value));
+        }
+    }
+    LiteralInfo info;
+    info.valid = true;
+    info.firstBytes = bytes;
+    return info;
+}
+
+LiteralInfo repeat(const LiteralInfo& a, uint32_t min, uint32_t max) {
+    if (max == 0) return empty();
+    LiteralInfo info = empty();
+    if (a.isExact) {
+        // Copiile obligatorii ale unui literal formeaza direct alt literal
+        for (uint32_t i = 0; i < min; ++i) info.exact += a.exact;
+        info.nullable = info.exact.empty();
+        info.prefix = info.suffix = info.required = info.exact;
+        info.firstBytes = a.firstBytes;
+    }
+    else {
+        // Dupa doua copii prefixul, sufixul si jonctiunea dintre copii nu se mai schimba
+        for (uint32_t i = 0; i < std::min<uint32_t>(min, 2); ++i) info = concatenate(info, a);
+    }
+    // Copiile optionale nu adauga literali, doar octeti de inceput
+    return max == min ? info : concatenate(info, star(a));
+}
+
+}
+
+LiteralInfo analyzePolishNotation(const std::string& polishExpression) {
+    std::stack<LiteralInfo> infos;
+
+    for (char symbol : polishExpression) {
+        if (std::isalnum(static_cast<unsigned char>(symbol))) {
+            infos.push(literal(symbol));
+        }
+        else if (symbol == '|' || symbol == '.' || symbol == '+') {
+            if (infos.size() < 2) return LiteralInfo();
+            LiteralInfo b = infos.top(); infos.pop();
+            LiteralInfo a = infos.top(); infos.pop();
+            infos.push(symbol == '|' ? alternate(a, b) : concatenate(a, b));
+        }
+        else if (symbol == '*') {
+            if (infos.empty()) return LiteralInfo();
+            LiteralInfo a = infos.top(); infos.pop();
+            infos.push(star(a));
+        }
+    }
+
+    if (infos.empty()) return LiteralInfo();
+    return infos.top();
+}
+
+LiteralInfo analyze(const RegexAst& ast) {
+    const std::vector<RegexAst::Node>& nodes = ast.getNodes();
+    if (nodes.empty()) return LiteralInfo();
+    std::vector<LiteralInfo> infos;
+
+    // Postordine: operanzii sunt deja pe stiva cand ajungem la operator
+    for (uint32_t index = nodes[ast.getRoot()].first; index <= ast.getRoot(); ++index) {
+        const RegexAst::Node& node = nodes[index];
+        switch (node.kind) {
+        case RegexAst::Node::Kind::Empty:
+            infos.push_back(empty());
+            break;
+        case RegexAst::Node::Kind::Set:
+            infos.push_back(byteSet(ast.getSets()[node.set]));
+            break;
+        case RegexAst::Node::Kind::Concat:
+        case RegexAst::Node::Kind::Alternate: {
+            LiteralInfo b = std::move(infos.back()); infos.pop_back();
+            LiteralInfo a = std::move(infos.back()); infos.pop_back();
+            infos.push_back(node.kind == RegexAst::Node::Kind::Concat ? concatenate(a, b) : alternate(a, b));
+            break;
+        }
+        case RegexAst::Node::Kind::Repeat: {
+            LiteralInfo a = std::move(infos.back()); infos.pop_back();
+            infos.push_back(repeat(a, node.min, node.max));
+            break;
+        }
+        }
+    }
+
+    if (infos.empty()) return LiteralInfo();
+    return infos.back();
+}
+
+Prefilter::Prefilter() : kind(Kind::None), bytes{ 0, 0, 0 }, byteCount(0) {
+}
+
+Prefilter::Prefilter(const LiteralInfo& info) : Prefilter() {
+    // Cand cuvantul vid e acceptat, orice pozitie poate fi inceput de potrivire
+    if (!info.valid || info.nullable) return;
+
+    required = info.required;
+    if (info.prefix.size() >= 2) {
+        kind = Kind::Literal;
+        literal = info.prefix;
+        return;
+    }
+
+    size_t count = info.firstBytes.count();
+    if (count == 0 || count > 3) return;
+
+    for (unsigned value = 0; value < 256; ++value) {
+        if (info.firstBytes.test(value)) bytes[byteCount++] = static_cast<unsigned char>(value);
+    }
+    kind = count == 1 ? Kind::Byte : Kind::ByteSet;
+}
+
+bool Prefilter::mayMatch(std::string_view text) const {
+    return required.empty() || text.find(required) != std::string_view::npos;
+}
+
+size_t Prefilter::findCandidate(std::string_view text, size_t from) const {
+    if (from >= text.size()) return std::string_view::npos;
+
+    switch (kind) {
+    case Kind::Byte: {
+        const void* found = std::memchr(text.data() + from, bytes[0], text.size() - from);
+        return found ? static_cast<size_t>(static_cast<const char*>(found) - text.data()) : std::string_view::npos;
+    }
+    case Kind::ByteSet:
+        return findByteSet(text, from);
+    case Kind::Literal:
+        return text.find(literal, from);
+    default:
+        return from;
+    }
+}
+
+size_t Prefilter::findByteSet(std::string_view text, size_t from) const {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    size_t i = from;
+
+#ifdef PREFILTER_SSE2
+    // 16 octeti odata: comparatie cu fiecare octet din multime, apoi masca de biti
+    const __m128i first = _mm_set1_epi8(static_cast<char>(bytes[0]));
+    const __m128i second = _mm_set1_epi8(static_cast<char>(bytes[1]));
+    const __m128i third = _mm_set1_epi8(static_cast<char>(bytes[byteCount > 2 ? 2 : 1]));
+    for (; i + 16 <= text.size(); i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, first), _mm_cmpeq_epi8(block, second)),
+            _mm_cmpeq_epi8(block, third));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask) {
+            unsigned offset = 0;
+            while (!(mask & 1)) {
+                mask >>= 1;
+                ++offset;
+            }
+            return i + offset;
+        }
+    }
+#endif
+
+    for (; i < text.size(); ++i) {
+        unsigned char value = data[i];
+        if (value == bytes[0] || value == bytes[1] || (byteCount > 2 && value == bytes[2])) return i;
+    }
+    return std::string_view::npos;
+}
+
+const char* PrefilterKindName(Prefilter::Kind kind) {
+    switch (kind) {
+    case Prefilter::Kind::Byte: return "byte";
+    case Prefilter::Kind::ByteSet: return "byte-set";
+    case Prefilter::Kind::Literal: return "literal";
+    default: return "none";
+    }
+}
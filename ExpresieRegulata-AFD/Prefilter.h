@@ -0,0 +1,56 @@
+﻿#pragma once
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class RegexAst;
+
+// Informatii despre literalii unei (sub)expresii
+struct LiteralInfo {
+    bool valid = false;         // expresia a putut fi analizata
+    bool nullable = false;      // limbajul contine cuvantul vid
+    bool isExact = false;       // limbajul este exact cuvantul `exact`
+    std::string exact;
+    std::string prefix;         // prefix comun tuturor cuvintelor
+    std::string suffix;         // sufix comun tuturor cuvintelor
+    std::string required;       // subcuvant continut de orice cuvant
+    std::bitset<256> firstBytes; // octetii cu care poate incepe un cuvant nevid
+};
+
+// Analizeaza forma poloneza acceptata de buildLambdaNFA (litere si cifre, '.' sau '+', '|', '*')
+LiteralInfo analyzePolishNotation(const std::string& polishExpression);
+// Aceeasi analiza pe arborele sintactic (RegexAst::parse): clasele cu un singur
+// octet sunt literali, iar x{m,n} se socoteste ca m copii urmate de o parte optionala
+LiteralInfo analyze(const RegexAst& ast);
+
+// Sare rapid la pozitiile unde poate incepe o potrivire, inainte de a porni automatul
+class Prefilter {
+public:
+    enum class Kind { None, Byte, ByteSet, Literal };
+
+    Prefilter();
+    explicit Prefilter(const LiteralInfo& info);
+
+    Kind getKind() const { return kind; }
+    bool isActive() const { return kind != Kind::None; }
+    const std::string& getRequired() const { return required; }
+
+    // Prima pozitie >= from unde poate incepe o potrivire, sau npos
+    size_t findCandidate(std::string_view text, size_t from) const;
+
+    // Fals daca textul sigur nu contine nicio potrivire
+    bool mayMatch(std::string_view text) const;
+
+private:
+    size_t findByteSet(std::string_view text, size_t from) const;
+
+    Kind kind;
+    std::string literal;   // pentru Literal; pentru Byte primul octet
+    unsigned char bytes[3];
+    int byteCount;
+    std::string required;
+};
+
+const char* PrefilterKindName(Prefilter::Kind kind);
@@ -0,0 +1,105 @@
+﻿#include "RegexEngine.h"
+#include "LambdaNFA.h"
+#include "SparseSet.h"
+#include <iostream>
+#include <utility>
+
+RegexEngine::RegexEngine()
+    : kind(Kind::DFA) {
+}
+
+RegexEngine RegexEngine::fromAst(const RegexAst& ast) {
+    return fromAst(ast, Options());
+}
+
+RegexEngine RegexEngine::fromAst(const RegexAst& ast, const Options& options) {
+    RegexEngine engine;
+    if (GlushkovMatcher::fromAst(ast, engine.bitParallel)) {
+        engine.kind = Kind::BitParallel;
+        return engine;
+    }
+
+    // Prea multe pozitii sau repetari {m,n}
+    LambdaNFA lambdaNFA = buildLambdaNFA(ast);
+    DeterminizeLimits limits;
+    limits.maxStates = options.maxDfaStates;
+    limits.maxBytes = options.maxDfaBytes;
+    if (!lambdaNFA.toMinimalAutomaton(limits, engine.dfa)) {
+        engine.kind = Kind::NFA;
+        engine.nfa = NFAMatcher(std::move(lambdaNFA));
+    }
+    return engine;
+}
+
+RegexEngine RegexEngine::fromPolishNotation(const std::string& polishExpression) {
+    RegexAst ast;
+    RegexError error;
+    if (!RegexAst::fromPolishNotation(polishExpression, ast, &error)) {
+        std::cerr << "Eroare: " << error.message << ".\n";
+        return RegexEngine();
+    }
+    return fromAst(ast);
+}
+
+bool RegexEngine::fromExpression(const std::string& expression, RegexEngine& result) {
+    return fromExpression(expression, result, Options());
+}
+
+bool RegexEngine::fromExpression(const std::string& expression, RegexEngine& result, const Options& options) {
+    RegexAst ast;
+    RegexError error;
+    if (!RegexAst::parse(expression, ast, &error)) {
+        PrintRegexError(expression, error);
+        return false;
+    }
+
+    result = fromAst(ast, options);
+    return true;
+}
+
+bool RegexEngine::CheckWord(std::string_view word) const {
+    switch (kind) {
+    case Kind::BitParallel: return bitParallel.CheckWord(word);
+    case Kind::DFA: return dfa.matches(word);
+    case Kind::NFA: return nfa.CheckWord(word);
+    }
+    return false;
+}
+
+bool RegexEngine::search(std::string_view text) const {
+    switch (kind) {
+    case Kind::BitParallel: return bitParallel.search(text);
+    case Kind::NFA: return nfa.search(text);
+    case Kind::DFA: break;
+    }
+
+    // Pe AFD ancorat: multimea starilor in care se afla potrivirile incepute
+    // pana acum; de obicei ramane mica, pentru ca starile moarte ies din ea
+    const uint32_t start = dfa.getStartState();
+    if (dfa.isAccepting(start)) return true;
+
+    SparseSet first(dfa.getStateCount());
+    SparseSet second(dfa.getStateCount());
+    SparseSet* current = &first;
+    SparseSet* following = &second;
+    for (unsigned char symbol : text) {
+        current->insert(start);
+        following->clear();
+        for (uint32_t state : *current) {
+            const uint32_t target = dfa.next(state, symbol);
+            if (target == CompiledAutomaton::kDeadState || !following->insert(target)) continue;
+            if (dfa.isAccepting(target)) return true;
+        }
+        std::swap(current, following);
+    }
+    return false;
+}
+
+const char* EngineKindName(RegexEngine::Kind kind) {
+    switch (kind) {
+    case RegexEngine::Kind::BitParallel: return "bit-parallel";
+    case RegexEngine::Kind::DFA: return "dfa";
+    case RegexEngine::Kind::NFA: return "nfa";
+    }
+    return "?";
+}
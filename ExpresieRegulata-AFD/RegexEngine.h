@@ -0,0 +1,44 @@
+﻿#pragma once
+#include <string>
+#include <string_view>
+#include "CompiledAutomaton.h"
+#include "GlushkovMatcher.h"
+#include "NFAMatcher.h"
+#include "RegexParser.h"
+
+// Alege motorul de potrivire dupa marimea tiparului: pentru tipare mici
+// automatul Glushkov bit-paralel (compilare fara determinizare), pentru restul
+// AFD-ul minimizat, iar daca AFD-ul depaseste bugetul, simularea AFN.
+class RegexEngine {
+public:
+    enum class Kind { BitParallel, DFA, NFA };
+
+    struct Options {
+        // Limitele constructiei submultimilor; 0 inseamna fara limita
+        size_t maxDfaStates = 1 << 16;
+        size_t maxDfaBytes = 64 << 20;
+    };
+
+    // Limbajul vid, pe AFD
+    RegexEngine();
+
+    static RegexEngine fromAst(const RegexAst& ast);
+    static RegexEngine fromAst(const RegexAst& ast, const Options& options);
+    static RegexEngine fromPolishNotation(const std::string& polishExpression);
+    // Expresie regulata -> arbore sintactic -> motor; fals daca expresia e invalida
+    static bool fromExpression(const std::string& expression, RegexEngine& result);
+    static bool fromExpression(const std::string& expression, RegexEngine& result, const Options& options);
+
+    Kind getKind() const { return kind; }
+    bool CheckWord(std::string_view word) const;
+    // Adevarat daca un subsir al textului (eventual vid) este in limbaj
+    bool search(std::string_view text) const;
+
+private:
+    Kind kind;
+    GlushkovMatcher bitParallel;
+    CompiledAutomaton dfa;
+    NFAMatcher nfa;
+};
+
+const char* EngineKindName(RegexEngine::Kind kind);
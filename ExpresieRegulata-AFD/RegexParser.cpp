@@ -0,0 +1,489 @@
+﻿#include "RegexParser.h"
+#include "PipelineStats.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+using Kind = RegexAst::Node::Kind;
+
+// Gramatica:
+//   alternare  := concatenare ('|' concatenare)*
+//   concatenare := repetare*
+//   repetare   := atom ('*' | '+' | '?' | '{' m [',' [n]] '}')*
+//   atom       := octet | '.' | clasa | escape | '(' alternare ')'
+class RegexParser {
+public:
+    RegexParser(const std::string& expression, RegexAst& ast) : expression(expression), ast(ast) {}
+
+    bool run(RegexError* error) {
+        parseAlternation(0);
+        if (!failed && !atEnd()) {
+            fail(position, "paranteza ')' nu are pereche");
+        }
+        if (failed && error) *error = this->error;
+        return !failed;
+    }
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+    // Limita de imbricare a parantezelor, ca recursivitatea sa nu depaseasca stiva
+    static constexpr uint32_t kMaxDepth = 1000;
+
+    // Nodul construit si marimea subarborelui dupa expandarea repetarilor
+    struct Parsed {
+        uint32_t node;
+        uint64_t size;
+    };
+
+    bool atEnd() const { return position >= expression.size(); }
+    unsigned char peek() const { return static_cast<unsigned char>(expression[position]); }
+
+    void fail(size_t at, const char* message) {
+        if (failed) return;
+        failed = true;
+        error.position = at;
+        error.message = message;
+    }
+
+    Parsed addNode(Kind kind, uint32_t first, uint32_t left, uint32_t right, uint32_t set,
+        uint32_t min, uint32_t max, uint64_t size, size_t at) {
+        if (size > RegexAst::kMaxExpandedSize) {
+            fail(at, "expresia expandata este prea mare");
+            return { kNone, 0 };
+        }
+        const uint32_t index = static_cast<uint32_t>(ast.nodes.size());
+        ast.nodes.push_back({ kind, first == kNone ? index : first, left, right, set, min, max });
+        return { index, size };
+    }
+
+    Parsed addSet(const std::bitset<256>& bytes, size_t at) {
+        ast.sets.push_back(bytes);
+        return addNode(Kind::Set, kNone, kNone, kNone, static_cast<uint32_t>(ast.sets.size() - 1), 0, 0, 1, at);
+    }
+
+    Parsed addBinary(Kind kind, const Parsed& a, const Parsed& b, size_t at) {
+        return addNode(kind, ast.nodes[a.node].first, a.node, b.node, 0, 0, 0, a.size + b.size + 1, at);
+    }
+
+    Parsed parseAlternation(uint32_t depth) {
+        Parsed result = parseConcatenation(depth);
+        while (!failed && !atEnd() && peek() == '|') {
+            const size_t at = position++;
+            Parsed next = parseConcatenation(depth);
+            if (failed) break;
+            result = addBinary(Kind::Alternate, result, next, at);
+        }
+        return result;
+    }
+
+    Parsed parseConcatenation(uint32_t depth) {
+        const size_t at = position;
+        Parsed result{ kNone, 0 };
+        while (!failed && !atEnd() && peek() != '|' && peek() != ')') {
+            Parsed next = parseRepeat(depth);
+            if (failed) break;
+            result = result.node == kNone ? next : addBinary(Kind::Concat, result, next, at);
+        }
+        if (!failed && result.node == kNone) {
+            result = addNode(Kind::Empty, kNone, kNone, kNone, 0, 0, 0, 1, at);
+        }
+        return result;
+    }
+
+    Parsed parseRepeat(uint32_t depth) {
+        const size_t at = position;
+        Parsed result = parseAtom(depth);
+        while (!failed && !atEnd()) {
+            uint32_t min = 0;
+            uint32_t max = RegexAst::kUnbounded;
+            const unsigned char symbol = peek();
+            if (symbol == '*') {
+                ++position;
+            }
+            else if (symbol == '+') {
+                min = 1;
+                ++position;
+            }
+            else if (symbol == '?') {
+                max = 1;
+                ++position;
+            }
+            else if (symbol == '{') {
+                if (!parseCount(min, max)) break;
+            }
+            else {
+                break;
+            }
+            if (max == 0) {
+                // x{0} si x{0,0} potrivesc doar cuvantul vid: operandul (sufixul nodurilor si
+                // al multimilor) se scoate din arbore, iar in locul lui ramane un nod vid
+                const uint32_t first = ast.nodes[result.node].first;
+                for (uint32_t index = first; index < ast.nodes.size(); ++index) {
+                    if (ast.nodes[index].kind == Kind::Set) {
+                        ast.sets.resize(std::min<size_t>(ast.sets.size(), ast.nodes[index].set));
+                    }
+                }
+                ast.nodes.resize(first);
+                result = addNode(Kind::Empty, kNone, kNone, kNone, 0, 0, 0, 1, at);
+                continue;
+            }
+            // Un operand neinfinit apare de max ori; unul nemarginit, de cel mult max(min, 1) ori
+            const uint64_t copies = max == RegexAst::kUnbounded ? std::max<uint32_t>(min, 1) : std::max<uint32_t>(max, 1);
+            result = addNode(Kind::Repeat, ast.nodes[result.node].first, result.node, kNone, 0, min, max,
+                result.size * copies + 1, at);
+        }
+        return result;
+    }
+
+    // {m}, {m,} sau {m,n}; pozitia curenta este pe '{'
+    bool parseCount(uint32_t& min, uint32_t& max) {
+        const size_t open = position++;
+        if (!readNumber(min)) {
+            fail(position, "se astepta un numar dupa '{'");
+            return false;
+        }
+        max = min;
+        if (!atEnd() && peek() == ',') {
+            ++position;
+            if (!readNumber(max)) max = RegexAst::kUnbounded;
+        }
+        if (atEnd() || peek() != '}') {
+            fail(position, "se astepta '}' la sfarsitul repetarii");
+            return false;
+        }
+        ++position;
+        if (min > RegexAst::kMaxRepeat || (max != RegexAst::kUnbounded && max > RegexAst::kMaxRepeat)) {
+            fail(open, "numarul de repetari depaseste 1000");
+            return false;
+        }
+        if (max < min) {
+            fail(open, "in {m,n} trebuie ca m <= n");
+            return false;
+        }
+        return true;
+    }
+
+    bool readNumber(uint32_t& value) {
+        if (atEnd() || !std::isdigit(peek())) return false;
+        value = 0;
+        while (!atEnd() && std::isdigit(peek())) {
+            value = std::min<uint32_t>(value * 10 + (peek() - '0'), RegexAst::kMaxRepeat + 1);
+            ++position;
+        }
+        return true;
+    }
+
+    Parsed parseAtom(uint32_t depth) {
+        const size_t at = position;
+        const unsigned char symbol = peek();
+        std::bitset<256> bytes;
+
+        switch (symbol) {
+        case '(': {
+            if (depth == kMaxDepth) {
+                fail(at, "prea multe paranteze imbricate");
+                return { kNone, 0 };
+            }
+            ++position;
+            Parsed inner = parseAlternation(depth + 1);
+            if (failed) return inner;
+            if (atEnd() || peek() != ')') {
+                fail(at, "paranteza '(' nu este inchisa");
+                return { kNone, 0 };
+            }
+            ++position;
+            return inner;
+        }
+        case '[':
+            if (!parseClass(bytes)) return { kNone, 0 };
+            return addSet(bytes, at);
+        case '.':
+            ++position;
+            bytes.set();
+            bytes.reset('\n');
+            return addSet(bytes, at);
+        case '\\':
+            if (!parseEscape(bytes)) return { kNone, 0 };
+            return addSet(bytes, at);
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+            fail(at, "operatorul de repetare nu are operand");
+            return { kNone, 0 };
+        case '^':
+        case '$':
+            fail(at, "ancorele ^ si $ nu sunt suportate; potrivirea este deja ancorata");
+            return { kNone, 0 };
+        default:
+            ++position;
+            bytes.set(symbol);
+            return addSet(bytes, at);
+        }
+    }
+
+    // Pozitia curenta este pe '\'; adauga octetii secventei in `bytes`
+    bool parseEscape(std::bitset<256>& bytes) {
+        const size_t at = position++;
+        if (atEnd()) {
+            fail(at, "secventa escape incompleta la sfarsitul expresiei");
+            return false;
+        }
+        const unsigned char symbol = peek();
+        ++position;
+        switch (symbol) {
+        case 'n': bytes.set('\n'); return true;
+        case 't': bytes.set('\t'); return true;
+        case 'r': bytes.set('\r'); return true;
+        case 'f': bytes.set('\f'); return true;
+        case 'v': bytes.set('\v'); return true;
+        case 'x': {
+            int value = 0;
+            for (int digit = 0; digit < 2; ++digit) {
+                if (atEnd() || !std::isxdigit(peek())) {
+                    fail(at, "\\x trebuie urmat de doua cifre hexazecimale");
+                    return false;
+                }
+                const unsigned char hex = peek();
+                value = value * 16 + (std::isdigit(hex) ? hex - '0' : std::tolower(hex) - 'a' + 10);
+                ++position;
+            }
+            bytes.set(static_cast<size_t>(value));
+            return true;
+        }
+        case 'd':
+        case 'D':
+        case 'w':
+        case 'W':
+        case 's':
+        case 'S': {
+            std::bitset<256> predefined;
+            for (unsigned value = 0; value < 256; ++value) {
+                const char lower = static_cast<char>(std::tolower(symbol));
+                bool member = lower == 'd' ? (value >= '0' && value <= '9')
+                    : lower == 'w' ? (std::isalnum(value) && value < 128) || value == '_'
+                    : value == ' ' || (value >= '\t' && value <= '\r');
+                predefined[value] = member;
+            }
+            if (std::isupper(symbol)) predefined.flip();
+            bytes |= predefined;
+            return true;
+        }
+        default:
+            if (std::isalnum(symbol)) {
+                fail(at, "secventa escape necunoscuta");
+                return false;
+            }
+            bytes.set(symbol);
+            return true;
+        }
+    }
+
+    // Un singur octet dintr-o clasa (caracter sau escape); -1 pentru clasele predefinite
+    int parseClassByte(std::bitset<256>& bytes) {
+        if (peek() == '\\') {
+            std::bitset<256> escaped;
+            if (!parseEscape(escaped)) return -1;
+            bytes |= escaped;
+            if (escaped.count() != 1) return -1;
+            int value = 0;
+            while (!escaped.test(static_cast<size_t>(value))) ++value;
+            return value;
+        }
+        const int value = peek();
+        ++position;
+        bytes.set(static_cast<size_t>(value));
+        return value;
+    }
+
+    // Pozitia curenta este pe '['
+    bool parseClass(std::bitset<256>& bytes) {
+        const size_t open = position++;
+        bool negated = false;
+        if (!atEnd() && peek() == '^') {
+            negated = true;
+            ++position;
+        }
+
+        bool firstItem = true;
+        while (true) {
+            if (atEnd()) {
+                fail(open, "clasa '[' nu este inchisa");
+                return false;
+            }
+            // ']' imediat dupa '[' sau '[^' este un octet obisnuit
+            if (peek() == ']' && !firstItem) {
+                ++position;
+                break;
+            }
+            firstItem = false;
+
+            const size_t itemStart = position;
+            const int low = parseClassByte(bytes);
+            if (failed) return false;
+
+            const bool isRange = position + 1 < expression.size() && peek() == '-' && expression[position + 1] != ']';
+            if (!isRange) continue;
+            if (low < 0) {
+                fail(itemStart, "o clasa predefinita nu poate fi capat de interval");
+                return false;
+            }
+            ++position;
+            const size_t highStart = position;
+            const int high = parseClassByte(bytes);
+            if (failed) return false;
+            if (high < 0) {
+                fail(highStart, "o clasa predefinita nu poate fi capat de interval");
+                return false;
+            }
+            if (high < low) {
+                fail(itemStart, "interval invers in clasa");
+                return false;
+            }
+            for (int value = low; value <= high; ++value) bytes.set(static_cast<size_t>(value));
+        }
+
+        if (negated) bytes.flip();
+        return true;
+    }
+
+    const std::string& expression;
+    RegexAst& ast;
+    size_t position = 0;
+    bool failed = false;
+    RegexError error;
+};
+
+bool RegexAst::parse(const std::string& expression, RegexAst& result, RegexError* error) {
+    REGEX_AFD_STAGE(PipelineStage::Parse);
+    RegexAst ast;
+    RegexParser parser(expression, ast);
+    if (!parser.run(error)) {
+        return false;
+    }
+    result = std::move(ast);
+    return true;
+}
+
+bool RegexAst::fromPolishNotation(const std::string& polishExpression, RegexAst& result, RegexError* error) {
+    REGEX_AFD_STAGE(PipelineStage::Parse);
+    RegexAst ast;
+    std::vector<uint32_t> operands;
+    auto fail = [&](size_t position, const std::string& message) {
+        if (error) *error = { position, message };
+        return false;
+    };
+
+    for (size_t position = 0; position < polishExpression.size(); ++position) {
+        const char symbol = polishExpression[position];
+        const uint32_t index = static_cast<uint32_t>(ast.nodes.size());
+        if (std::isalnum(static_cast<unsigned char>(symbol))) {
+            std::bitset<256> bytes;
+            bytes.set(static_cast<unsigned char>(symbol));
+            ast.sets.push_back(bytes);
+            ast.nodes.push_back({ Node::Kind::Set, index, 0, 0, static_cast<uint32_t>(ast.sets.size() - 1), 0, 0 });
+        }
+        else if (symbol == '|' || symbol == '.' || symbol == '+') {
+            if (operands.size() < 2) {
+                return fail(position, std::string("prea putine automate pentru operatorul '") + symbol + "'");
+            }
+            const uint32_t right = operands.back(); operands.pop_back();
+            const uint32_t left = operands.back(); operands.pop_back();
+            const Node::Kind kind = symbol == '|' ? Node::Kind::Alternate : Node::Kind::Concat;
+            ast.nodes.push_back({ kind, ast.nodes[left].first, left, right, 0, 0, 0 });
+        }
+        else if (symbol == '*') {
+            if (operands.empty()) return fail(position, "niciun automat pentru operatorul '*'");
+            const uint32_t operand = operands.back(); operands.pop_back();
+            ast.nodes.push_back({ Node::Kind::Repeat, ast.nodes[operand].first, operand, 0, 0, 0, kUnbounded });
+        }
+        else {
+            continue;
+        }
+        operands.push_back(index);
+    }
+
+    if (operands.size() != 1) {
+        return fail(polishExpression.size(),
+            "forma poloneza lasa " + std::to_string(operands.size()) + " automate pe stiva");
+    }
+    result = std::move(ast);
+    return true;
+}
+
+namespace {
+
+bool isSpecial(unsigned char symbol) {
+    return std::strchr(".|*+?()[]{}\\^$", symbol) != nullptr && symbol != '\0';
+}
+
+void appendByte(std::string& out, unsigned char symbol) {
+    if (std::isgraph(symbol) && !isSpecial(symbol)) {
+        out += static_cast<char>(symbol);
+        return;
+    }
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "\\x%02X", symbol);
+    out += buffer;
+}
+
+void appendSet(std::string& out, const std::bitset<256>& bytes) {
+    if (bytes.count() == 1) {
+        for (unsigned value = 0; value < 256; ++value) {
+            if (bytes.test(value)) appendByte(out, static_cast<unsigned char>(value));
+        }
+        return;
+    }
+    out += '[';
+    for (unsigned value = 0; value < 256;) {
+        if (!bytes.test(value)) {
+            ++value;
+            continue;
+        }
+        unsigned end = value;
+        while (end + 1 < 256 && bytes.test(end + 1)) ++end;
+        appendByte(out, static_cast<unsigned char>(value));
+        if (end > value) {
+            if (end > value + 1) out += '-';
+            appendByte(out, static_cast<unsigned char>(end));
+        }
+        value = end + 1;
+    }
+    out += ']';
+}
+
+}
+
+std::string RegexAst::toString() const {
+    std::string result;
+    for (const Node& node : nodes) {
+        switch (node.kind) {
+        case Node::Kind::Empty: result += "()"; break;
+        case Node::Kind::Set: appendSet(result, sets[node.set]); break;
+        case Node::Kind::Concat: result += '.'; break;
+        case Node::Kind::Alternate: result += '|'; break;
+        case Node::Kind::Repeat:
+            if (node.min == 0 && node.max == kUnbounded) result += '*';
+            else if (node.min == 1 && node.max == kUnbounded) result += '+';
+            else if (node.min == 0 && node.max == 1) result += '?';
+            else {
+                result += '{' + std::to_string(node.min);
+                if (node.max != node.min) {
+                    result += ',';
+                    if (node.max != kUnbounded) result += std::to_string(node.max);
+                }
+                result += '}';
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+void PrintRegexError(const std::string& expression, const RegexError& error) {
+    std::cerr << "Eroare la coloana " << error.position + 1 << ": " << error.message << "\n"
+        << "  " << expression << "\n"
+        << "  " << std::string(error.position, ' ') << "^\n";
+}
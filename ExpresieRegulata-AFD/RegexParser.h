@@ -0,0 +1,69 @@
+﻿#pragma once
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Eroare de sintaxa: pozitia (octetul, de la 0) unde a fost detectata si mesajul
+struct RegexError {
+    size_t position = 0;
+    std::string message;
+};
+
+// Arborele sintactic al unei expresii regulate, construit dintr-o singura trecere
+// de un parser cu descendenta recursiva. Nodurile sunt tinute in postordine
+// (operanzii inaintea operatorului), deci un subarbore ocupa un interval
+// contiguu [first, nod] si poate fi parcurs fara recursie, cu o stiva, ca
+// forma poloneza.
+//
+// Sintaxa:
+//   a|b  alternare      ab  concatenare      ( )  grupare
+//   *  +  ?  {m}  {m,}  {m,n}  repetare
+//   .  orice octet in afara de '\n'
+//   [abc]  [a-z0-9]  [^...]  clase de octeti
+//   \n \t \r \f \v \xHH  \d \w \s \D \W \S  si \ urmat de orice caracter special
+// Clasele raman un singur nod cu o multime de octeti pana la tranzitiile AFD.
+class RegexAst {
+public:
+    static constexpr uint32_t kUnbounded = UINT32_MAX;
+    // Limita pentru m si n din {m,n}
+    static constexpr uint32_t kMaxRepeat = 1000;
+    // Limita pentru numarul de noduri dupa expandarea repetarilor
+    static constexpr uint64_t kMaxExpandedSize = 1 << 20;
+
+    struct Node {
+        enum class Kind : uint8_t { Empty, Set, Concat, Alternate, Repeat };
+        Kind kind;
+        uint32_t first; // primul nod al subarborelui
+        uint32_t left;  // Concat/Alternate: operandul stang; Repeat: operandul
+        uint32_t right; // Concat/Alternate: operandul drept
+        uint32_t set;   // Set: indexul in getSets()
+        uint32_t min;   // Repeat
+        uint32_t max;   // Repeat; kUnbounded pentru * si +
+    };
+
+    // Fals daca expresia e invalida; detaliile ajung in `error`, daca e dat
+    static bool parse(const std::string& expression, RegexAst& result, RegexError* error = nullptr);
+
+    // Forma poloneza interna: litere si cifre ca operanzi, '.' (sau '+')
+    // concatenare, '|' alternare, '*' stelare; restul caracterelor se ignora.
+    // Este deja in postordine, deci se citeste cu o stiva, fara recursie.
+    static bool fromPolishNotation(const std::string& polishExpression, RegexAst& result, RegexError* error = nullptr);
+
+    const std::vector<Node>& getNodes() const { return nodes; }
+    const std::vector<std::bitset<256>>& getSets() const { return sets; }
+    uint32_t getRoot() const { return static_cast<uint32_t>(nodes.size() - 1); }
+
+    // Forma poloneza a arborelui, pentru afisare: clasele apar intre [], ε ca "()"
+    std::string toString() const;
+
+private:
+    friend class RegexParser;
+
+    std::vector<Node> nodes;
+    std::vector<std::bitset<256>> sets;
+};
+
+// Afiseaza eroarea cu expresia si un marcaj sub pozitia gresita
+void PrintRegexError(const std::string& expression, const RegexError& error);
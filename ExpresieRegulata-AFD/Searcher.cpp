@@ -0,0 +1,106 @@
+﻿#include "Searcher.h"
+
+Searcher::Searcher() {
+    buildStartsMatch();
+}
+
+Searcher::Searcher(const Searcher& other)
+    : forward(other.forward), reachability(other.reachability), startsMatch(other.startsMatch), prefilter(other.prefilter),
+    bytesSkipped(other.bytesSkipped.load()), candidates(other.candidates.load()) {
+}
+
+Searcher& Searcher::operator=(const Searcher& other) {
+    forward = other.forward;
+    reachability = other.reachability;
+    startsMatch = other.startsMatch;
+    prefilter = other.prefilter;
+    bytesSkipped.store(other.bytesSkipped.load());
+    candidates.store(other.candidates.load());
+    return *this;
+}
+
+bool Searcher::fromNFA(const LambdaNFA& nfa, Searcher& result, const Prefilter& prefilter,
+    const DeterminizeLimits& limits) {
+    Searcher searcher;
+    if (!nfa.toMinimalAutomaton(limits, searcher.forward)
+        || !AcceptReachability::fromAutomaton(searcher.forward, limits, searcher.reachability)) {
+        return false;
+    }
+    searcher.buildStartsMatch();
+    searcher.prefilter = prefilter;
+    result = searcher;
+    return true;
+}
+
+bool Searcher::fromPolishNotation(const std::string& polishExpression, Searcher& result,
+    const DeterminizeLimits& limits) {
+    if (!fromNFA(buildLambdaNFA(polishExpression), result, Prefilter(analyzePolishNotation(polishExpression)), limits)) {
+        PrintLimitsExceeded(polishExpression, limits);
+        return false;
+    }
+    return true;
+}
+
+bool Searcher::fromExpression(const std::string& expression, Searcher& result, RegexError* error,
+    const DeterminizeLimits& limits) {
+    RegexAst ast;
+    RegexError parseError;
+    if (!RegexAst::parse(expression, ast, &parseError)) {
+        if (error) *error = parseError;
+        else PrintRegexError(expression, parseError);
+        return false;
+    }
+    if (!fromNFA(buildLambdaNFA(ast), result, Prefilter(analyze(ast)), limits)) {
+        if (error) *error = RegexError{ 0, "automatul depaseste limitele de determinizare" };
+        else PrintLimitsExceeded(expression, limits);
+        return false;
+    }
+    return true;
+}
+
+void Searcher::buildStartsMatch() {
+    startsMatch.assign(reachability.getStateCount(), 0);
+    for (uint32_t state = 1; state < reachability.getStateCount(); ++state) {
+        startsMatch[state] = reachability.canAccept(state, forward.getStartState());
+    }
+}
+
+Searcher::PrefilterStats Searcher::getPrefilterStats() const {
+    PrefilterStats stats;
+    stats.kind = prefilter.getKind();
+    stats.required = prefilter.getRequired();
+    stats.bytesSkipped = bytesSkipped.load(std::memory_order_relaxed);
+    stats.candidates = candidates.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Searcher::recordSkipped(uint64_t bytes, uint64_t candidateCount) const {
+    bytesSkipped.fetch_add(bytes, std::memory_order_relaxed);
+    candidates.fetch_add(candidateCount, std::memory_order_relaxed);
+}
+
+size_t Searcher::matchFrom(std::string_view text, size_t start, size_t& stop) const {
+    uint32_t state = forward.getStartState();
+    size_t end = forward.isAccepting(state) ? start : std::string_view::npos;
+
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    size_t i = start;
+    for (; i < text.size(); ++i) {
+        state = forward.next(state, data[i]);
+        if (state == CompiledAutomaton::kDeadState) break;
+        if (forward.isAccepting(state)) end = i + 1;
+    }
+
+    stop = i;
+    return end;
+}
+
+std::vector<Searcher::Match> Searcher::findAll(std::string_view text) const {
+    std::vector<Match> matches;
+    forEachMatch(text, [&](const Match& match) { matches.push_back(match); });
+    return matches;
+}
+
+std::vector<Searcher::Match> Searcher::findAll(const char* data, size_t size) const {
+    return findAll(std::string_view(data, size));
+}
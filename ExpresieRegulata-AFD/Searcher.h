@@ -0,0 +1,172 @@
+﻿#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AcceptReachability.h"
+#include "CompiledAutomaton.h"
+#include "LambdaNFA.h"
+#include "Prefilter.h"
+
+// Cautare neancorata in text: gaseste toate potrivirile leftmost-longest,
+// fara suprapuneri, intr-un buffer oarecare.
+//
+// Se folosesc doua AFD:
+//  - L ancorat inainte (`forward`), din fiecare inceput, pentru potrivirea cea mai lunga;
+//  - AcceptReachability peste `forward` (`reachability`): citind textul de la
+//    sfarsit, starea lui la pozitia k este multimea starilor lui `forward` din care
+//    textul de la k mai duce intr-o stare finala.
+// Un inceput de potrivire este o pozitie unde starea initiala a lui `forward` e in
+// aceasta multime, iar rularea ancorata se opreste imediat ce iese din ea, adica
+// imediat dupa ultima ei stare finala. Fiecare octet e citit deci de un numar
+// constant de ori, chiar si pentru a|a*b pe "aaa...", iar cautarea e liniara.
+//
+// Trecerea inapoi se face fereastra cu fereastra (AcceptReachability::Scan), deci
+// memoria nu depinde de marimea textului. Cu un prefiltru activ se ruleaza doar AFD ancorat din pozitiile
+// candidate (salturi memchr/SSE2); daca rularile citesc prea mult dincolo de
+// potriviri, restul textului trece pe drumul de mai sus.
+class Searcher {
+public:
+    struct Match {
+        size_t start;
+        size_t end; // exclusiv
+    };
+
+    struct PrefilterStats {
+        Prefilter::Kind kind = Prefilter::Kind::None;
+        std::string required;
+        uint64_t bytesSkipped = 0;
+        uint64_t candidates = 0;
+    };
+
+    // Limbajul vid
+    Searcher();
+    Searcher(const Searcher& other);
+    Searcher& operator=(const Searcher& other);
+
+    // Din AFN-ul cu λ-tranzitii, de exemplu rezultatul lui buildLambdaNFA; fals, fara
+    // mesaj, daca AFD-ul sau automatul inapoi depasesc limitele
+    static bool fromNFA(const LambdaNFA& nfa, Searcher& result, const Prefilter& prefilter = Prefilter(),
+        const DeterminizeLimits& limits = DeterminizeLimits::standard());
+    // Construieste AFN-ul si prefiltrul din aceeasi forma poloneza
+    static bool fromPolishNotation(const std::string& polishExpression, Searcher& result,
+        const DeterminizeLimits& limits = DeterminizeLimits::standard());
+    // La fel, din sintaxa infixata (RegexAst::parse); fals daca expresia e invalida
+    // sau automatele depasesc limitele, cu eroarea afisata sau intoarsa in `error`
+    static bool fromExpression(const std::string& expression, Searcher& result, RegexError* error = nullptr,
+        const DeterminizeLimits& limits = DeterminizeLimits::standard());
+
+    std::vector<Match> findAll(std::string_view text) const;
+    std::vector<Match> findAll(const char* data, size_t size) const;
+
+    // Apeleaza onMatch(Match) pentru fiecare potrivire, fara a le colecta
+    template <typename F>
+    void forEachMatch(std::string_view text, F&& onMatch) const;
+
+    PrefilterStats getPrefilterStats() const;
+
+private:
+    static constexpr size_t kWindow = AcceptReachability::kWindow;
+
+    void buildStartsMatch();
+    // Sfarsitul celei mai lungi potriviri ancorate in `start`, sau npos; `stop`
+    // primeste pozitia la care s-a oprit rularea
+    size_t matchFrom(std::string_view text, size_t start, size_t& stop) const;
+    void recordSkipped(uint64_t bytes, uint64_t candidates) const;
+
+    // Toate potrivirile care incep de la `position` incolo, pe automatul inapoi
+    template <typename F>
+    void forEachMatchFrom(std::string_view text, size_t position, F&& onMatch) const;
+    template <typename F>
+    void forEachCandidate(std::string_view text, F&& onMatch) const;
+
+    CompiledAutomaton forward;
+    AcceptReachability reachability;
+    // reachability.canAccept(r, starea initiala a lui forward): o potrivire incepe aici
+    std::vector<uint8_t> startsMatch;
+    Prefilter prefilter;
+
+    // Contoare per tipar, actualizate o data per cautare
+    mutable std::atomic<uint64_t> bytesSkipped{ 0 };
+    mutable std::atomic<uint64_t> candidates{ 0 };
+};
+
+template <typename F>
+void Searcher::forEachCandidate(std::string_view text, F&& onMatch) const {
+    uint64_t skipped = 0;
+    uint64_t candidateCount = 0;
+    // Octetii cititi de rularile ancorate dupa sfarsitul potrivirii lor (sau dupa
+    // candidat, daca nu s-a potrivit nimic); ar putea creste patratic
+    uint64_t overscan = 0;
+    size_t position = 0;
+
+    while (position < text.size()) {
+        if (overscan > 2 * position + kWindow) {
+            recordSkipped(skipped, candidateCount);
+            forEachMatchFrom(text, position, onMatch);
+            return;
+        }
+        size_t candidate = prefilter.findCandidate(text, position);
+        if (candidate == std::string_view::npos) {
+            skipped += text.size() - position;
+            break;
+        }
+        skipped += candidate - position;
+        ++candidateCount;
+
+        size_t stop = candidate;
+        size_t end = matchFrom(text, candidate, stop);
+        if (end == std::string_view::npos) {
+            overscan += stop - candidate;
+            position = candidate + 1;
+            continue;
+        }
+        overscan += stop - end;
+        onMatch(Match{ candidate, end });
+        position = end; // prefiltrul exista doar daca nu se accepta cuvantul vid
+    }
+
+    recordSkipped(skipped, candidateCount);
+}
+
+template <typename F>
+void Searcher::forEachMatchFrom(std::string_view text, size_t position, F&& onMatch) const {
+    AcceptReachability::Scan scan(reachability, text);
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    const uint32_t startState = forward.getStartState();
+
+    while (position <= text.size()) {
+        if (!startsMatch[scan.at(position)]) {
+            ++position;
+            continue;
+        }
+
+        // Starea ramane in multimea lui `reachability`, deci rularea se opreste chiar dupa
+        // ultima stare finala, iar end este gasit
+        const size_t start = position;
+        uint32_t state = startState;
+        size_t end = forward.isAccepting(state) ? start : std::string_view::npos;
+        for (size_t i = start; i < text.size(); ++i) {
+            state = forward.next(state, data[i]);
+            if (!scan.canAccept(i + 1, state)) break;
+            if (forward.isAccepting(state)) end = i + 1;
+        }
+        onMatch(Match{ start, end });
+        position = end > start ? end : start + 1;
+    }
+}
+
+template <typename F>
+void Searcher::forEachMatch(std::string_view text, F&& onMatch) const {
+    if (!prefilter.mayMatch(text)) {
+        recordSkipped(text.size(), 0);
+        return;
+    }
+    if (prefilter.isActive()) {
+        forEachCandidate(text, onMatch);
+        return;
+    }
+    forEachMatchFrom(text, 0, onMatch);
+}
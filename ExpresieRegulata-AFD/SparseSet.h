@@ -0,0 +1,49 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+
+// Multime de stari cu clear() in O(1) si iterare in ordinea insertiei
+// (reprezentarea sparse/dense a lui Briggs si Torczon)
+class SparseSet {
+public:
+    SparseSet() = default;
+    explicit SparseSet(uint32_t capacity) : sparse(capacity, 0), dense(capacity, 0), count(0) {}
+
+    void resize(uint32_t capacity) {
+        sparse.assign(capacity, 0);
+        dense.assign(capacity, 0);
+        count = 0;
+    }
+
+    bool contains(uint32_t value) const {
+        uint32_t index = sparse[value];
+        return index < count && dense[index] == value;
+    }
+
+    // Presupune ca valoarea nu este deja in multime
+    void insertNew(uint32_t value) {
+        sparse[value] = count;
+        dense[count++] = value;
+    }
+
+    bool insert(uint32_t value) {
+        if (contains(value)) return false;
+        insertNew(value);
+        return true;
+    }
+
+    uint32_t capacity() const { return static_cast<uint32_t>(sparse.size()); }
+    void clear() { count = 0; }
+    bool empty() const { return count == 0; }
+    uint32_t size() const { return count; }
+
+    const uint32_t* begin() const { return dense.data(); }
+    const uint32_t* end() const { return dense.data() + count; }
+    uint32_t* begin() { return dense.data(); }
+    uint32_t* end() { return dense.data() + count; }
+
+private:
+    std::vector<uint32_t> sparse;
+    std::vector<uint32_t> dense;
+    uint32_t count = 0;
+};
@@ -0,0 +1,92 @@
+﻿#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Multime de stari ale unui AFN, reprezentata ca bitset dinamic
+class StateSet {
+public:
+    StateSet() = default;
+    explicit StateSet(uint32_t capacity) : bits((capacity + 63) / 64, 0) {}
+
+    void insert(uint32_t state) { bits[state >> 6] |= uint64_t(1) << (state & 63); }
+    bool contains(uint32_t state) const { return (bits[state >> 6] >> (state & 63)) & 1; }
+
+    void unite(const StateSet& other) {
+        for (size_t i = 0; i < bits.size(); ++i) bits[i] |= other.bits[i];
+    }
+
+    bool intersects(const StateSet& other) const {
+        for (size_t i = 0; i < bits.size(); ++i) {
+            if (bits[i] & other.bits[i]) return true;
+        }
+        return false;
+    }
+
+    bool empty() const {
+        for (uint64_t word : bits) {
+            if (word) return false;
+        }
+        return true;
+    }
+
+    void clear() { std::fill(bits.begin(), bits.end(), 0); }
+
+    size_t count() const {
+        size_t total = 0;
+        forEach([&](uint32_t) { ++total; });
+        return total;
+    }
+
+    // Apeleaza f(stare) pentru fiecare bit setat, in ordine crescatoare
+    template <typename F>
+    void forEach(F&& f) const {
+        for (size_t i = 0; i < bits.size(); ++i) {
+            uint64_t word = bits[i];
+            while (word) {
+                f(static_cast<uint32_t>(i * 64 + countTrailingZeros(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+    size_t hash() const {
+        uint64_t h = 1469598103934665603ull; // FNV-1a pe cuvinte
+        for (uint64_t word : bits) {
+            h ^= word;
+            h *= 1099511628211ull;
+        }
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+
+    bool operator==(const StateSet& other) const { return bits == other.bits; }
+    bool operator!=(const StateSet& other) const { return bits != other.bits; }
+
+    const std::vector<uint64_t>& words() const { return bits; }
+
+private:
+    static unsigned countTrailingZeros(uint64_t word) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return index;
+#elif defined(_MSC_VER)
+        unsigned long index;
+        if (_BitScanForward(&index, static_cast<unsigned long>(word))) return index;
+        _BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+        return index + 32;
+#else
+        return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+    }
+
+    std::vector<uint64_t> bits;
+};
+
+struct StateSetHash {
+    size_t operator()(const StateSet& set) const { return set.hash(); }
+};
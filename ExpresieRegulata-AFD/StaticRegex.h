@@ -0,0 +1,215 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+// Pipeline-ul expresie -> AFD evaluat integral la compilare, pentru tiparele fixe
+// din cod. Expresia infixata (litere, cifre si spatiul, concatenare implicita,
+// '|', '*', '+', '?', paranteze; subsetul literal al sintaxei RegexAst) devine
+// automatul pozitiilor (Glushkov), apoi un AFD prin constructia submultimilor,
+// fara heap. Rezultatul este un tabel de dimensiune fixa; ca variabila
+// constexpr ajunge in datele read-only ale executabilului:
+//
+//   constexpr auto automaton = StaticAutomaton<16>::compile("a(b|c)*");
+//   static_assert(automaton.isValid(), "expresie invalida");
+//   automaton.CheckWord(word);
+//
+// Cu C++20 exista si forma compileRegex<"a(b|c)*">(), care verifica singura expresia.
+template <size_t MaxStates = 64>
+class StaticAutomaton {
+public:
+    // Bitul 0 este starea initiala a automatului pozitiilor
+    static constexpr uint32_t kMaxPositions = 63;
+    // Clasa 0 sunt octetii care nu apar in expresie; restul, cate una per simbol
+    static constexpr uint32_t kClassStride = 64;
+    static constexpr uint32_t kDeadState = 0;
+    static constexpr uint32_t kStartState = 1;
+
+    using State = std::conditional_t<(MaxStates <= 256), uint8_t, uint16_t>;
+    static_assert(MaxStates >= 2 && MaxStates <= 65536, "MaxStates trebuie sa fie intre 2 si 65536");
+
+    // Automat invalid (isValid() fals) daca expresia e gresita, are prea multi
+    // operanzi sau AFD-ul depaseste MaxStates stari
+    static constexpr StaticAutomaton compile(std::string_view expression) {
+        StaticAutomaton automaton;
+        Parser parser{ expression };
+        const PositionSets root = parser.parseAlternation();
+        if (parser.failed || parser.index != expression.size()) return automaton;
+
+        parser.follow[0] = root.first;
+        const uint64_t acceptMask = root.last | (root.nullable ? 1 : 0);
+
+        // Clasele de octeti: cate una pentru fiecare simbol distinct din expresie
+        uint64_t classMasks[kClassStride] = {};
+        for (uint32_t position = 1; position <= parser.positionCount; ++position) {
+            const unsigned char symbol = parser.symbols[position];
+            if (automaton.classMap[symbol] == 0) automaton.classMap[symbol] = static_cast<uint8_t>(++automaton.classCount);
+            classMasks[automaton.classMap[symbol]] |= uint64_t(1) << position;
+        }
+        automaton.classCount += 1;
+
+        // Constructia submultimilor; sets[s] este multimea pozitiilor starii s
+        uint64_t sets[MaxStates] = {};
+        sets[kStartState] = 1;
+        automaton.stateCount = 2;
+        for (uint32_t state = kStartState; state < automaton.stateCount; ++state) {
+            automaton.accepting[state] = (sets[state] & acceptMask) != 0;
+            uint64_t reachable = 0;
+            for (uint32_t position = 0; position <= parser.positionCount; ++position) {
+                if ((sets[state] >> position) & 1) reachable |= parser.follow[position];
+            }
+            for (uint32_t byteClass = 1; byteClass < automaton.classCount; ++byteClass) {
+                const uint64_t target = reachable & classMasks[byteClass];
+                if (target == 0) continue;
+                uint32_t found = kDeadState;
+                for (uint32_t other = kStartState; other < automaton.stateCount && found == kDeadState; ++other) {
+                    if (sets[other] == target) found = other;
+                }
+                if (found == kDeadState) {
+                    if (automaton.stateCount == MaxStates) return StaticAutomaton();
+                    found = automaton.stateCount++;
+                    sets[found] = target;
+                }
+                automaton.table[state * kClassStride + byteClass] = static_cast<State>(found);
+            }
+        }
+        automaton.valid = true;
+        return automaton;
+    }
+
+    constexpr bool isValid() const { return valid; }
+    // Include starea moarta 0
+    constexpr uint32_t getStateCount() const { return stateCount; }
+    constexpr uint32_t getClassCount() const { return classCount; }
+
+    constexpr bool CheckWord(std::string_view word) const {
+        uint32_t state = kStartState;
+        for (char symbol : word) {
+            state = table[state * kClassStride + classMap[static_cast<unsigned char>(symbol)]];
+            if (state == kDeadState) return false;
+        }
+        return accepting[state];
+    }
+
+private:
+    struct PositionSets {
+        bool nullable;
+        uint64_t first;
+        uint64_t last;
+    };
+
+    // Descendent recursiv peste expresia infixata; calculeaza direct first/last/follow
+    struct Parser {
+        std::string_view expression;
+        size_t index = 0;
+        bool failed = false;
+        uint32_t positionCount = 0;
+        unsigned char symbols[kMaxPositions + 1] = {};
+        uint64_t follow[kMaxPositions + 1] = {};
+
+        // Spatiul e literal, ca in RegexAst::parse
+        static constexpr bool isOperand(char symbol) {
+            return (symbol >= 'a' && symbol <= 'z') || (symbol >= 'A' && symbol <= 'Z') || (symbol >= '0' && symbol <= '9')
+                || symbol == ' ';
+        }
+
+        constexpr char peek() const {
+            return index < expression.size() ? expression[index] : '\0';
+        }
+
+        constexpr void addFollow(uint64_t from, uint64_t targets) {
+            for (uint32_t position = 0; position <= positionCount; ++position) {
+                if ((from >> position) & 1) follow[position] |= targets;
+            }
+        }
+
+        constexpr PositionSets parseAlternation() {
+            PositionSets result = parseConcatenation();
+            while (!failed && peek() == '|') {
+                ++index;
+                const PositionSets next = parseConcatenation();
+                result = { result.nullable || next.nullable, result.first | next.first, result.last | next.last };
+            }
+            return result;
+        }
+
+        constexpr PositionSets parseConcatenation() {
+            PositionSets result = parseStar();
+            while (!failed) {
+                const char symbol = peek();
+                if (!isOperand(symbol) && symbol != '(') break;
+                const PositionSets next = parseStar();
+                addFollow(result.last, next.first);
+                result = { result.nullable && next.nullable,
+                    result.first | (result.nullable ? next.first : 0),
+                    next.last | (next.nullable ? result.last : 0) };
+            }
+            return result;
+        }
+
+        constexpr PositionSets parseStar() {
+            PositionSets result = parseAtom();
+            while (!failed) {
+                const char symbol = peek();
+                if (symbol != '*' && symbol != '+' && symbol != '?') break;
+                ++index;
+                if (symbol != '?') addFollow(result.last, result.first);
+                if (symbol != '+') result.nullable = true;
+            }
+            return result;
+        }
+
+        constexpr PositionSets parseAtom() {
+            const char symbol = peek();
+            if (isOperand(symbol)) {
+                ++index;
+                if (positionCount == kMaxPositions) {
+                    failed = true;
+                    return {};
+                }
+                symbols[++positionCount] = static_cast<unsigned char>(symbol);
+                const uint64_t bit = uint64_t(1) << positionCount;
+                return { false, bit, bit };
+            }
+            if (symbol == '(') {
+                ++index;
+                const PositionSets inner = parseAlternation();
+                if (peek() != ')') {
+                    failed = true;
+                    return {};
+                }
+                ++index;
+                return inner;
+            }
+            failed = true;
+            return {};
+        }
+    };
+
+    bool valid = false;
+    uint32_t stateCount = 0;
+    uint32_t classCount = 0;
+    uint8_t classMap[256] = {};
+    bool accepting[MaxStates] = {};
+    State table[MaxStates * kClassStride] = {};
+};
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+// Literal de tip sir folosibil ca argument de sablon (C++20)
+template <size_t N>
+struct StaticExpression {
+    char text[N] = {};
+    constexpr StaticExpression(const char (&expression)[N]) {
+        for (size_t i = 0; i < N; ++i) text[i] = expression[i];
+    }
+};
+
+template <StaticExpression Expression, size_t MaxStates = 64>
+constexpr StaticAutomaton<MaxStates> compileRegex() {
+    constexpr StaticAutomaton<MaxStates> automaton =
+        StaticAutomaton<MaxStates>::compile(std::string_view(Expression.text, sizeof(Expression.text) - 1));
+    static_assert(automaton.isValid(), "Expresia regulata este invalida sau depaseste MaxStates stari");
+    return automaton;
+}
+#endif
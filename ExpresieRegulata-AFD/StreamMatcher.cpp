@@ -0,0 +1,63 @@
+﻿#include "StreamMatcher.h"
+#include "PipelineStats.h"
+
+StreamMatcher::StreamMatcher(const CompiledAutomaton& automaton, Mode mode)
+    : automaton(&automaton), mode(mode) {
+    reset();
+}
+
+void StreamMatcher::reset() {
+    state = automaton->getStartState();
+    offset = 0;
+    status = Status::Running;
+    if (state == CompiledAutomaton::kDeadState) {
+        status = Status::Dead;
+    }
+    else if (mode == Mode::Search && automaton->isAccepting(state)) {
+        status = Status::Found; // cuvantul vid e acceptat
+    }
+}
+
+StreamMatcher::Status StreamMatcher::feed(const char* data, size_t size) {
+    if (status != Status::Running) return status;
+    REGEX_AFD_STAGE(PipelineStage::Matching);
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    uint32_t current = state;
+    size_t i = 0;
+    if (mode == Mode::Anchored) {
+        for (; i < size; ++i) {
+            current = automaton->next(current, bytes[i]);
+            if (current == CompiledAutomaton::kDeadState) {
+                status = Status::Dead;
+                ++i;
+                break;
+            }
+        }
+    }
+    else {
+        for (; i < size; ++i) {
+            current = automaton->next(current, bytes[i]);
+            if (current == CompiledAutomaton::kDeadState) {
+                status = Status::Dead;
+                ++i;
+                break;
+            }
+            if (automaton->isAccepting(current)) {
+                status = Status::Found;
+                ++i;
+                break;
+            }
+        }
+    }
+
+    REGEX_AFD_RECORD(pipeline.bytesScanned += i; pipeline.deadStateExits += status == Status::Dead);
+    state = current;
+    offset += i;
+    return status;
+}
+
+bool StreamMatcher::finish() const {
+    if (mode == Mode::Search) return status == Status::Found;
+    return status == Status::Running && automaton->isAccepting(state);
+}
@@ -0,0 +1,47 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "CompiledAutomaton.h"
+
+// Potrivire pe un flux primit pe bucati (pachete de retea, segmente de log),
+// fara a copia datele: intre apeluri se pastreaza doar starea AFD si offsetul.
+// Automatul nu este copiat si trebuie sa traiasca cat obiectul.
+//
+//  - Anchored: tot fluxul trebuie sa fie in limbaj, ca la CheckWord;
+//    feed se opreste devreme cand se ajunge in starea moarta.
+//  - Search: se opreste la primul octet dupa care automatul e intr-o stare
+//    finala. Cu automatul lui nfa.unanchored() gaseste sfarsitul primei
+//    potriviri din flux; cu cel ancorat, cel mai scurt prefix acceptat.
+class StreamMatcher {
+public:
+    enum class Mode { Anchored, Search };
+    enum class Status {
+        Running, // se asteapta alte date
+        Dead,    // nicio continuare nu mai poate fi acceptata
+        Found    // doar in Search: o stare finala a fost atinsa
+    };
+
+    explicit StreamMatcher(const CompiledAutomaton& automaton, Mode mode = Mode::Anchored);
+
+    // Consuma o bucata; dupa Dead sau Found, restul datelor sunt ignorate
+    Status feed(const char* data, size_t size);
+    Status feed(std::string_view chunk) { return feed(chunk.data(), chunk.size()); }
+
+    // Sfarsitul fluxului: Anchored - fluxul este acceptat; Search - s-a gasit o potrivire
+    bool finish() const;
+
+    // Reia de la inceputul unui flux nou
+    void reset();
+
+    Status getStatus() const { return status; }
+    // Octetii consumati; dupa Dead/Found, pozitia imediat dupa octetul decisiv
+    uint64_t getOffset() const { return offset; }
+
+private:
+    const CompiledAutomaton* automaton;
+    Mode mode;
+    Status status;
+    uint32_t state;
+    uint64_t offset;
+};
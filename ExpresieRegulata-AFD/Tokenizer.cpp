@@ -0,0 +1,113 @@
+﻿#include "Tokenizer.h"
+#include "LambdaNFA.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+Tokenizer::Tokenizer() : ruleCount(0), stateRule(2, kNoRule) {
+}
+
+bool Tokenizer::fromRules(const std::vector<Rule>& rules, Tokenizer& result, const DeterminizeLimits& limits) {
+    std::vector<LambdaNFA> nfas(rules.size());
+    for (size_t i = 0; i < rules.size(); ++i) {
+        if (!LambdaNFA::fromExpression(rules[i].expression, nfas[i])) {
+            std::cerr << "Eroare: Regula " << i << " (" << rules[i].expression << ") este invalida.\n";
+            return false;
+        }
+    }
+
+    const LambdaNFA combined = LambdaNFA::combine(nfas);
+    SubsetConstruction construction;
+    if (!combined.determinize(limits, construction)) {
+        PrintLimitsExceeded("reguli", limits);
+        return false;
+    }
+    const uint32_t dfaStates = static_cast<uint32_t>(construction.sets.size());
+
+    Tokenizer tokenizer;
+    tokenizer.ruleCount = rules.size();
+
+    // Starile submultimilor se decaleaza cu 1, ca 0 sa ramana starea moarta
+    tokenizer.automaton = CompiledAutomaton(dfaStates + 1, 1, construction.classes);
+    for (const auto& transition : construction.transitions) {
+        tokenizer.automaton.setClassTransition(transition.from + 1, transition.byteClass, transition.to + 1);
+    }
+    tokenizer.automaton.mergeEquivalentClasses();
+
+    tokenizer.stateRule.assign(dfaStates + 1, kNoRule);
+    for (uint32_t id = 0; id < dfaStates; ++id) {
+        uint32_t best = kNoRule;
+        construction.sets[id].forEach([&](uint32_t state) {
+            if (combined.isAccepting(state) && combined.getAcceptTag(state) < best) {
+                best = combined.getAcceptTag(state);
+            }
+        });
+        if (best != kNoRule) {
+            tokenizer.automaton.setAccepting(id + 1, true);
+            tokenizer.stateRule[id + 1] = rules[best].id;
+        }
+    }
+    if (!AcceptReachability::fromAutomaton(tokenizer.automaton, limits, tokenizer.reachability)) {
+        PrintLimitsExceeded("reguli (cautarea inapoi)", limits);
+        return false;
+    }
+
+    result = std::move(tokenizer);
+    return true;
+}
+
+bool Tokenizer::fromFile(const std::string& path, Tokenizer& result, const DeterminizeLimits& limits) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Fisierul nu a putut fi deschis: " << path << "\n";
+        return false;
+    }
+
+    std::vector<Rule> rules;
+    std::string line;
+    for (size_t lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        std::istringstream stream(line);
+        Rule rule;
+        if (!(stream >> rule.id >> std::ws) || !std::getline(stream, rule.expression)) {
+            std::cerr << "Eroare: Linia " << lineNumber << " trebuie sa fie \"<id> <expresie>\".\n";
+            return false;
+        }
+        rules.push_back(std::move(rule));
+    }
+
+    return fromRules(rules, result, limits);
+}
+
+size_t Tokenizer::tokenize(std::string_view input, std::vector<Token>& tokens) const {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(input.data());
+    const size_t size = input.size();
+    const uint32_t start = automaton.getStartState();
+    AcceptReachability::Scan scan(reachability, input);
+
+    size_t position = 0;
+    while (position < size) {
+        uint32_t state = start;
+        size_t lastEnd = position;
+        uint32_t lastRule = kNoRule;
+
+        for (size_t i = position; i < size; ++i) {
+            state = automaton.next(state, data[i]);
+            // Include starea moarta; dupa ultimul token posibil nu se mai citeste nimic
+            if (!scan.canAccept(i + 1, state)) break;
+            if (stateRule[state] != kNoRule) {
+                lastEnd = i + 1;
+                lastRule = stateRule[state];
+            }
+        }
+
+        if (lastRule == kNoRule) {
+            break;
+        }
+        tokens.push_back({ position, static_cast<uint32_t>(lastEnd - position), lastRule });
+        position = lastEnd;
+    }
+    return position;
+}
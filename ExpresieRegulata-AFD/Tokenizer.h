@@ -0,0 +1,60 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AcceptReachability.h"
+#include "CompiledAutomaton.h"
+
+// Un token: octetii [offset, offset + length) din intrare, recunoscuti de regula id
+struct Token {
+    size_t offset;
+    uint32_t length;
+    uint32_t id;
+};
+
+// Analizor lexical: o lista ordonata de reguli (expresie, id) compilata intr-un
+// singur AFD, ca la PatternSet. Fiecare stare finala retine regula cu cea mai
+// mare prioritate (prima din lista) dintre cele care accepta acolo.
+//
+// tokenize alege la fiecare pozitie cel mai lung token (leftmost-longest):
+// AFD-ul avanseaza cat timp mai poate ajunge intr-o stare finala (AcceptReachability,
+// cu o trecere inapoi peste intrare), tinand minte ultima stare finala, apoi reia
+// de dupa ea. Rularea se opreste deci imediat dupa tokenul gasit, iar timpul e
+// liniar si pentru reguli ca "a" si "a*b" pe "aaa...".
+class Tokenizer {
+public:
+    static constexpr uint32_t kNoRule = UINT32_MAX;
+
+    struct Rule {
+        std::string expression;
+        uint32_t id;
+    };
+
+    Tokenizer();
+
+    // Fals daca o expresie e invalida sau AFD-ul combinat depaseste limitele
+    static bool fromRules(const std::vector<Rule>& rules, Tokenizer& result,
+        const DeterminizeLimits& limits = DeterminizeLimits::standard());
+    // Cate o regula pe linie: "<id> <expresie>", expresia fiind restul liniii
+    // (spatiile de la inceputul ei se ignora; pentru spatii se poate folosi \s).
+    // Liniile goale sunt ignorate
+    static bool fromFile(const std::string& path, Tokenizer& result,
+        const DeterminizeLimits& limits = DeterminizeLimits::standard());
+
+    // Adauga tokenurile in `tokens` (fara alocari per token) si intoarce numarul
+    // de octeti consumati: input.size() daca toata intrarea a fost impartita,
+    // altfel pozitia primului octet cu care nu incepe niciun token nevid
+    size_t tokenize(std::string_view input, std::vector<Token>& tokens) const;
+
+    size_t getRuleCount() const { return ruleCount; }
+    const CompiledAutomaton& getAutomaton() const { return automaton; }
+
+private:
+    size_t ruleCount;
+    CompiledAutomaton automaton;
+    AcceptReachability reachability;
+    // Id-ul regulii acceptate in fiecare stare, kNoRule pentru starile nefinale
+    std::vector<uint32_t> stateRule;
+};
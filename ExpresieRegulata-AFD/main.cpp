@@ -1,44 +1,282 @@
 ﻿#include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
 #include <string>
-#include "PolishForm.h"
+#include <vector>
 #include "DeterministicFiniteAutomaton.h"
+#include "PatternSet.h"
+#include "CodeGenerator.h"
+#include "PipelineStats.h"
+#include "StreamMatcher.h"
+#include "Tokenizer.h"
+#include "AutomatonEquivalence.h"
+#include "BatchMatcher.h"
 
-void meniu(const std::string& inputFilePath) {
-    // Citirea expresiei regulate din fișier
+// Citeste expresia regulata (prima linie) din fisier
+bool readExpression(const std::string& inputFilePath, std::string& expression) {
     std::ifstream file(inputFilePath);
     if (!file.is_open()) {
         std::cerr << "Fisierul nu a putut fi deschis: " << inputFilePath << "\n";
-        return;
+        return false;
     }
 
-    std::string expression;
     std::getline(file, expression);
     file.close();
 
     if (expression.empty()) {
         std::cerr << "Fisierul nu contine o expresie regulata valida.\n";
-        return;
+        return false;
     }
+    return true;
+}
 
-    std::cout << "Expresia regulata citita: " << expression << "\n";
+// Expresie -> arbore sintactic -> AFN cu λ-tranzitii -> AFD minimal; fals si daca
+// AFD-ul depaseste limitele
+bool buildAutomaton(const std::string& expression, const DeterminizeLimits& limits, std::string& polishNotation,
+    DeterministicFiniteAutomaton& dfa) {
+    RegexAst ast;
+    RegexError error;
+    if (!RegexAst::parse(expression, ast, &error)) {
+        PrintRegexError(expression, error);
+        return false;
+    }
+    polishNotation = ast.toString();
 
-    // Adăugarea "+" între caractere, dacă este necesar
-    std::string modifiedExpression = addPlusBetweenChars(expression);
+    // Construirea automatului finit determinist
+    auto lambdaNFA = buildLambdaNFA(ast);
+    if (!lambdaNFA.toDFA(limits, dfa)) {
+        PrintLimitsExceeded(expression, limits);
+        return false;
+    }
+    MinimizationStats minimizationStats;
+    dfa = dfa.minimize(&minimizationStats);
+    PrintMinimizationStats(minimizationStats);
+    return true;
+}
 
-    // Transformarea în forma poloneză
-    std::string polishNotation = toPolishNotation(modifiedExpression);
+// Compileaza expresia si salveaza tabelul AFD in format binar
+bool compileToFile(const std::string& inputFilePath, const std::string& compiledPath, const DeterminizeLimits& limits) {
+    std::string expression, polishNotation;
+    DeterministicFiniteAutomaton dfa;
+    if (!readExpression(inputFilePath, expression) || !buildAutomaton(expression, limits, polishNotation, dfa)) {
+        return false;
+    }
+
+    uint64_t sourceHash = HashBytes(expression.data(), expression.size());
+    if (!dfa.getCompiled().saveToFile(compiledPath, sourceHash, expression)) {
+        return false;
+    }
+    std::cout << "Automatul compilat a fost salvat in " << compiledPath << "\n";
+    return true;
+}
+
+// Refoloseste fisierul compilat daca provine din aceeasi expresie; altfel il recompileaza
+bool loadOrCompile(const std::string& inputFilePath, const std::string& compiledPath, const DeterminizeLimits& limits,
+    CompiledAutomaton& automaton) {
+    std::string expression;
+    if (!readExpression(inputFilePath, expression)) {
+        return false;
+    }
+
+    std::string storedExpression;
+    std::ifstream existing(compiledPath, std::ios::binary);
+    if (existing.is_open()) {
+        existing.close();
+        if (CompiledAutomaton::loadFromFile(compiledPath, automaton, true, nullptr, &storedExpression)
+            && storedExpression == expression) {
+            return true;
+        }
+    }
+
+    return compileToFile(inputFilePath, compiledPath, limits)
+        && CompiledAutomaton::loadFromFile(compiledPath, automaton);
+}
+
+// Verifica fiecare linie de la intrarea standard cu automatul compilat
+void checkWordsFromStdin(const CompiledAutomaton& automaton) {
+    std::string word;
+    while (std::getline(std::cin, word)) {
+        std::cout << word << (automaton.matches(word) ? ": acceptat\n" : ": respins\n");
+    }
+}
 
-    if (polishNotation.empty()) {
-        std::cerr << "Expresia regulata citita este invalida.\n";
+// Tot stdin-ul este un singur cuvant, citit pe bucati fara a fi pastrat in memorie
+void checkStreamFromStdin(const CompiledAutomaton& automaton) {
+    StreamMatcher matcher(automaton);
+    char buffer[1 << 16];
+    while (matcher.getStatus() == StreamMatcher::Status::Running && std::cin) {
+        std::cin.read(buffer, sizeof(buffer));
+        matcher.feed(buffer, static_cast<size_t>(std::cin.gcount()));
+    }
+    if (matcher.finish()) {
+        std::cout << "acceptat (" << matcher.getOffset() << " octeti)\n";
+    }
+    else {
+        std::cout << "respins dupa " << matcher.getOffset() << " octeti\n";
+    }
+}
+
+// Imparte tot stdin-ul in tokenuri si le afiseaza ca "offset lungime id"
+bool tokenizeStdin(const Tokenizer& tokenizer) {
+    std::string input((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+    std::vector<Token> tokens;
+    const size_t consumed = tokenizer.tokenize(input, tokens);
+    for (const Token& token : tokens) {
+        std::cout << token.offset << " " << token.length << " " << token.id << "\n";
+    }
+    if (consumed != input.size()) {
+        std::cerr << "Eroare: Niciun token nu incepe la pozitia " << consumed << ".\n";
+        return false;
+    }
+    return true;
+}
+
+// Scrie in outputPath tiparele din patternPath fara duplicate si fara cele incluse
+// in alt tipar; ce s-a eliminat si de ce apare la iesirea standard
+bool deduplicatePatterns(const std::string& patternPath, const std::string& outputPath, const DeterminizeLimits& limits) {
+    std::ifstream file(patternPath);
+    if (!file.is_open()) {
+        std::cerr << "Fisierul nu a putut fi deschis: " << patternPath << "\n";
+        return false;
+    }
+    std::vector<std::string> expressions;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) expressions.push_back(line);
+    }
+
+    RuleReduction reduction;
+    if (!ReduceRules(expressions, limits, reduction)) {
+        return false;
+    }
+
+    for (const auto& removed : reduction.removed) {
+        std::cout << expressions[removed.index]
+            << (removed.reason == RuleReduction::Reason::Duplicate ? " = " : " inclus in ")
+            << expressions[removed.keptBy] << "\n";
+    }
+    for (uint32_t index : reduction.unchecked) {
+        std::cout << expressions[index] << " pastrat fara comparatie (AFD prea mare)\n";
+    }
+
+    std::ofstream output(outputPath);
+    if (!output.is_open()) {
+        std::cerr << "Fisierul nu a putut fi creat: " << outputPath << "\n";
+        return false;
+    }
+    for (uint32_t index : reduction.kept) {
+        output << expressions[index] << "\n";
+    }
+    std::cout << expressions.size() << " tipare, " << reduction.kept.size() << " pastrate in " << outputPath << "\n";
+    return true;
+}
+
+// --batch <regex.txt | automat.afd> [cuvinte.txt | -] [--accepted | --count] [--threads n]
+// Expresia e compilata o singura data, fara mesaje; sumarul apare la stderr
+int runBatch(int argc, char* argv[], const DeterminizeLimits& limits) {
+    const std::string automatonPath = argv[2];
+    std::string inputPath = "-";
+    BatchMatcher::Options options;
+    for (int i = 3; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--accepted") options.output = BatchMatcher::Output::Accepted;
+        else if (argument == "--count") options.output = BatchMatcher::Output::Count;
+        else if (argument == "--threads" && i + 1 < argc) options.threadCount = static_cast<unsigned>(std::max(0, std::atoi(argv[++i])));
+        else if (argument.rfind("--", 0) != 0) inputPath = argument;
+        else {
+            std::cerr << "Optiune necunoscuta: " << argument << "\n";
+            return 1;
+        }
+    }
+
+    CompiledAutomaton automaton;
+    const bool isCompiled = automatonPath.size() > 4 && automatonPath.compare(automatonPath.size() - 4, 4, ".afd") == 0;
+    if (isCompiled) {
+        if (!CompiledAutomaton::loadFromFile(automatonPath, automaton)) return 1;
+    }
+    else {
+        std::string expression;
+        RegexAst ast;
+        RegexError error;
+        if (!readExpression(automatonPath, expression)) return 1;
+        if (!RegexAst::parse(expression, ast, &error)) {
+            PrintRegexError(expression, error);
+            return 1;
+        }
+        if (!buildLambdaNFA(ast).toMinimalAutomaton(limits, automaton)) {
+            PrintLimitsExceeded(expression, limits);
+            return 1;
+        }
+    }
+
+    std::ios::sync_with_stdio(false);
+    BatchMatcher matcher(automaton);
+    BatchMatcher::Summary summary;
+    if (!matcher.runFile(inputPath, std::cout, options, summary)) return 1;
+    std::cout.flush();
+    PrintBatchSummary(summary);
+    return 0;
+}
+
+// Construieste automatul si verifica cuvintele de la stdin, apoi scrie statisticile
+// pipeline-ului in format JSON (necesita compilare cu REGEX_AFD_STATS=1)
+bool runWithStats(const std::string& inputFilePath, const std::string& statsPath, const DeterminizeLimits& limits) {
+    PipelineStats stats;
+    {
+        PipelineStatsScope scope(stats);
+        std::string expression, polishNotation;
+        DeterministicFiniteAutomaton dfa;
+        if (!readExpression(inputFilePath, expression) || !buildAutomaton(expression, limits, polishNotation, dfa)) {
+            return false;
+        }
+        checkWordsFromStdin(dfa.getCompiled());
+    }
+    if (!REGEX_AFD_STATS) {
+        std::cerr << "Atentie: programul nu a fost compilat cu REGEX_AFD_STATS=1; statisticile sunt goale.\n";
+    }
+
+    std::ofstream file(statsPath);
+    if (!file.is_open()) {
+        std::cerr << "Eroare: Fisierul " << statsPath << " nu a putut fi creat.\n";
+        return false;
+    }
+    WritePipelineStatsJson(stats, file);
+    return true;
+}
+
+// Pentru fiecare linie de la stdin, afiseaza indicii tiparelor din set care o accepta
+void matchPatternSetFromStdin(const PatternSet& patternSet) {
+    std::vector<uint32_t> ids;
+    std::string word;
+    while (std::getline(std::cin, word)) {
+        patternSet.match(word, ids);
+        std::cout << word << ":";
+        for (uint32_t id : ids) {
+            std::cout << " " << id;
+        }
+        std::cout << "\n";
+    }
+}
+
+void meniu(const std::string& inputFilePath, const DeterminizeLimits& limits) {
+    // Citirea expresiei regulate din fișier
+    std::string expression;
+    if (!readExpression(inputFilePath, expression)) {
         return;
     }
 
-    std::cout << "Forma poloneza: " << polishNotation << std::endl;
+    std::cout << "Expresia regulata citita: " << expression << "\n";
 
-    // Construirea automatului finit determinist
-    auto lambdaNFA = buildLambdaNFA(polishNotation);
-    auto dfa = lambdaNFA.convertToDFA();
+    std::string polishNotation;
+    DeterministicFiniteAutomaton dfa;
+    if (!buildAutomaton(expression, limits, polishNotation, dfa)) {
+        return;
+    }
+
+    std::cout << "Forma poloneza: " << polishNotation << std::endl;
 
     // Meniul interactiv
     int optiune = -1;
@@ -86,12 +324,100 @@ void meniu(const std::string& inputFilePath) {
     }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     // Calea fișierului de intrare
     const std::string inputFilePath = "regex.txt";
 
+    // Moduri neinteractive pentru automate compilate in format binar:
+    //   --compile <regex.txt> <automat.afd>   compileaza o data si salveaza
+    //   --load <automat.afd>                  mapeaza fisierul si verifica cuvintele de la stdin
+    //   --cached <regex.txt> <automat.afd>    ca --load, recompiland doar daca expresia s-a schimbat
+    //   --set <tipare.txt>                    un tipar pe linie; afiseaza tiparele potrivite
+    //   --generate <tipare.txt> <antet.h> [namespace]   scrie potrivitoare C++ pentru tipare
+    //   --stats <regex.txt> <statistici.json>           recompileaza expresia (fara .afd), verifica
+    //                                         cuvintele de la stdin si scrie statisticile pipeline-ului
+    //   --stream <automat.afd>                intreg stdin-ul ca un singur cuvant, citit pe bucati
+    //   --tokenize <reguli.txt>               "<id> <expresie>" pe linie; imparte stdin-ul in tokenuri
+    //   --dedup <tipare.txt> <iesire.txt>     elimina tiparele echivalente sau incluse in altele
+    //   --batch <regex.txt | automat.afd> [cuvinte.txt] [--accepted | --count] [--threads n]
+    //                                         liste mari de cuvinte: "1"/"0" pe linie si un sumar
+    // Oriunde in linie, --max-dfa-states n si --max-dfa-bytes n schimba bugetul
+    // determinizarii (implicit DeterminizeLimits::standard(); 0 = fara limita)
+    DeterminizeLimits limits = DeterminizeLimits::standard();
+    std::vector<char*> arguments;
+    for (int i = 0; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if ((argument == "--max-dfa-states" || argument == "--max-dfa-bytes") && i + 1 < argc) {
+            char* end = nullptr;
+            const unsigned long long value = std::strtoull(argv[++i], &end, 10);
+            if (end == argv[i] || *end != '\0') {
+                std::cerr << "Eroare: " << argument << " asteapta un numar, nu \"" << argv[i] << "\".\n";
+                return 1;
+            }
+            (argument == "--max-dfa-states" ? limits.maxStates : limits.maxBytes) = static_cast<size_t>(value);
+        }
+        else {
+            arguments.push_back(argv[i]);
+        }
+    }
+    argc = static_cast<int>(arguments.size());
+    argv = arguments.data();
+
+    if (argc >= 2) {
+        const std::string mode = argv[1];
+        CompiledAutomaton automaton;
+        if (mode == "--compile" && argc == 4) {
+            return compileToFile(argv[2], argv[3], limits) ? 0 : 1;
+        }
+        if (mode == "--load" && argc == 3) {
+            if (!CompiledAutomaton::loadFromFile(argv[2], automaton)) return 1;
+            checkWordsFromStdin(automaton);
+            return 0;
+        }
+        if (mode == "--cached" && argc == 4) {
+            if (!loadOrCompile(argv[2], argv[3], limits, automaton)) return 1;
+            checkWordsFromStdin(automaton);
+            return 0;
+        }
+        if (mode == "--set" && argc == 3) {
+            PatternSet patternSet;
+            if (!PatternSet::fromFile(argv[2], patternSet, limits)) return 1;
+            matchPatternSetFromStdin(patternSet);
+            return 0;
+        }
+        if (mode == "--generate" && (argc == 4 || argc == 5)) {
+            return generateMatcherHeaderFile(argv[2], argv[3], argc == 5 ? argv[4] : "generated", limits) ? 0 : 1;
+        }
+        if (mode == "--stream" && argc == 3) {
+            if (!CompiledAutomaton::loadFromFile(argv[2], automaton)) return 1;
+            checkStreamFromStdin(automaton);
+            return 0;
+        }
+        if (mode == "--tokenize" && argc == 3) {
+            Tokenizer tokenizer;
+            if (!Tokenizer::fromFile(argv[2], tokenizer, limits)) return 1;
+            return tokenizeStdin(tokenizer) ? 0 : 1;
+        }
+        if (mode == "--batch" && argc >= 3) {
+            return runBatch(argc, argv, limits);
+        }
+        if (mode == "--dedup" && argc == 4) {
+            return deduplicatePatterns(argv[2], argv[3], limits) ? 0 : 1;
+        }
+        if (mode == "--stats" && argc == 4) {
+            return runWithStats(argv[2], argv[3], limits) ? 0 : 1;
+        }
+        std::cerr << "Utilizare: " << argv[0]
+            << " [--compile <regex> <afd> | --load <afd> | --cached <regex> <afd> | --set <tipare>"
+            << " | --generate <tipare> <antet> [namespace] | --stats <regex> <json>"
+            << " | --stream <afd> | --tokenize <reguli> | --dedup <tipare> <iesire>"
+            << " | --batch <regex|afd> [cuvinte] [--accepted|--count] [--threads n]]"
+            << " [--max-dfa-states n] [--max-dfa-bytes n]\n";
+        return 1;
+    }
+
     // Lansarea meniului interactiv
-    meniu(inputFilePath);
+    meniu(inputFilePath, limits);
 
     return 0;
 }
@@ -0,0 +1,142 @@
+﻿// Benchmark pentru potrivitoarele generate de ExpresieRegulata-AFD --generate.
+// Pentru fiecare tipar din aot_patterns.txt compara functia generata (compilata
+// in acest executabil) cu CheckWord pe tabelul AFD, pe acelasi corpus:
+//   random - cuvinte aleatoare din alfabetul a..h, de obicei respinse devreme
+//   walk   - drumuri aleatoare prin AFD, care raman vii pana la capat
+//
+// Utilizare: regex_aot_benchmark [--out fisier] [--label text] [--quick]
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "AotMatchers.h"
+#include "DeterministicFiniteAutomaton.h"
+#include "LambdaNFA.h"
+#include "BenchmarkCommon.h"
+
+namespace {
+
+using benchmark::measure;
+using benchmark::sink;
+
+struct Record {
+    std::string pattern;
+    std::string corpus;
+    std::string engine;
+    uint64_t iterations;
+    double nsPerOp;
+    uint64_t bytes;
+    size_t dfaStates;
+};
+
+std::vector<std::string> randomWords(size_t totalBytes, std::mt19937& rng) {
+    std::vector<std::string> words;
+    std::uniform_int_distribution<size_t> length(16, 256);
+    std::uniform_int_distribution<int> pick(0, 7);
+    size_t produced = 0;
+    while (produced < totalBytes) {
+        std::string word(length(rng), ' ');
+        for (char& symbol : word) symbol = static_cast<char>('a' + pick(rng));
+        produced += word.size();
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+// Fiecare pas alege o tranzitie spre o stare vie; cuvantul se opreste cand nu mai exista
+std::vector<std::string> walkWords(const CompiledAutomaton& automaton, size_t totalBytes, std::mt19937& rng) {
+    std::vector<std::string> words;
+    std::uniform_int_distribution<size_t> length(16, 256);
+    size_t produced = 0;
+    while (produced < totalBytes) {
+        std::string word;
+        uint32_t state = automaton.getStartState();
+        const size_t target = length(rng);
+        while (word.size() < target && state != CompiledAutomaton::kDeadState) {
+            std::vector<unsigned char> live;
+            for (unsigned byte = 0; byte < CompiledAutomaton::kAlphabetSize; ++byte) {
+                if (automaton.next(state, static_cast<unsigned char>(byte)) != CompiledAutomaton::kDeadState) {
+                    live.push_back(static_cast<unsigned char>(byte));
+                }
+            }
+            if (live.empty()) break;
+            unsigned char symbol = live[std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng)];
+            word += static_cast<char>(symbol);
+            state = automaton.next(state, symbol);
+        }
+        produced += word.size() + 1;
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+bool benchmarkPattern(const aot::Pattern& pattern, std::mt19937& rng, bool quick, std::vector<Record>& records) {
+    LambdaNFA nfa;
+    if (!LambdaNFA::fromExpression(pattern.expression, nfa)) return false;
+    const DeterministicFiniteAutomaton dfa = nfa.toDFA().minimize();
+    const size_t dfaStates = dfa.getStateCount();
+
+    const size_t corpusBytes = quick ? (1 << 18) : (1 << 22);
+    const struct {
+        const char* name;
+        std::vector<std::string> words;
+    } corpora[] = {
+        { "random", randomWords(corpusBytes, rng) },
+        { "walk", walkWords(dfa.getCompiled(), corpusBytes, rng) },
+    };
+
+    for (const auto& [name, words] : corpora) {
+        uint64_t bytes = 0;
+        for (const auto& word : words) {
+            bytes += word.size();
+            if (pattern.match(word) != dfa.CheckWord(word)) {
+                std::cerr << "Eroare: Functia generata pentru " << pattern.expression
+                    << " difera de CheckWord pe cuvantul " << word << "\n";
+                return false;
+            }
+        }
+
+        uint64_t iterations = 0;
+        double ns = measure([&] {
+            uint64_t accepted = 0;
+            for (const auto& word : words) accepted += dfa.CheckWord(word);
+            sink += accepted;
+        }, iterations);
+        records.push_back({ pattern.expression, name, "CheckWord", iterations, ns, bytes, dfaStates });
+
+        ns = measure([&] {
+            uint64_t accepted = 0;
+            for (const auto& word : words) accepted += pattern.match(word);
+            sink += accepted;
+        }, iterations);
+        records.push_back({ pattern.expression, name, "generated", iterations, ns, bytes, dfaStates });
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    benchmark::Options options;
+    if (!benchmark::parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::mt19937 rng(12345);
+    std::vector<Record> records;
+    for (const aot::Pattern& pattern : aot::kPatterns) {
+        std::cerr << "[" << pattern.expression << "]\n";
+        if (!benchmarkPattern(pattern, rng, options.quick, records)) return 1;
+    }
+
+    const bool written = benchmark::writeOutput(options, [&](std::ostream& out) {
+        benchmark::writeCsv(out, "pattern,corpus,engine,iterations,ns_per_op,bytes_per_op,bytes_per_sec,dfa_states",
+            records, options.label, [](std::ostream& row, const Record& record) {
+                row << record.pattern << "," << record.corpus << "," << record.engine << "," << record.iterations << ","
+                    << record.nsPerOp << "," << record.bytes << "," << benchmark::bytesPerSecond(record.bytes, record.nsPerOp)
+                    << "," << record.dfaStates;
+            });
+    });
+    return written ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+﻿#pragma once
+// Partea comuna a executabilelor de benchmark: masurarea, optiunile
+// --out/--label/--quick si scrierea rezultatelor CSV.
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef REGEX_AFD_VERSION
+#define REGEX_AFD_VERSION "dev"
+#endif
+
+namespace benchmark {
+
+// Rezultatele masurate ajung aici, ca optimizatorul sa nu elimine lucrul masurat
+inline volatile uint64_t sink = 0;
+
+struct Options {
+    std::string outputPath; // gol: iesirea standard
+    std::string label = "default";
+    bool quick = false;
+};
+
+// Ruleaza f() pana trec cel putin minNs nanosecunde; intoarce ns per apel
+template <typename F>
+double measure(F&& f, uint64_t& iterations, double minNs = 2e7) {
+    using Clock = std::chrono::steady_clock;
+    iterations = 0;
+    auto start = Clock::now();
+    double elapsed = 0;
+    do {
+        f();
+        ++iterations;
+        elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    } while (elapsed < minNs || iterations < 3);
+    return elapsed / iterations;
+}
+
+inline double bytesPerSecond(uint64_t bytes, double nsPerOp) {
+    return bytes ? bytes * 1e9 / nsPerOp : 0;
+}
+
+// extra(argument, i) trateaza optiunile proprii unui benchmark si intoarce fals
+// pentru cele necunoscute; poate consuma valori cu argv[++i]. Fals, cu mesajul
+// de utilizare afisat, la o optiune necunoscuta.
+template <typename Extra>
+bool parseOptions(int argc, char* argv[], Options& options, const char* extraUsage, Extra&& extra) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--out" && i + 1 < argc) options.outputPath = argv[++i];
+        else if (argument == "--label" && i + 1 < argc) options.label = argv[++i];
+        else if (argument == "--quick") options.quick = true;
+        else if (!extra(argument, i)) {
+            std::cerr << "Utilizare: " << argv[0] << " [--out fisier] [--label text] [--quick]" << extraUsage << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool parseOptions(int argc, char* argv[], Options& options) {
+    return parseOptions(argc, argv, options, "", [](const std::string&, int&) { return false; });
+}
+
+// write(out) scrie in options.outputPath sau, fara --out, la iesirea standard
+template <typename Write>
+bool writeOutput(const Options& options, Write&& write) {
+    if (options.outputPath.empty()) {
+        write(std::cout);
+        return true;
+    }
+    std::ofstream file(options.outputPath);
+    if (!file.is_open()) {
+        std::cerr << "Fisierul nu a putut fi creat: " << options.outputPath << "\n";
+        return false;
+    }
+    write(file);
+    return true;
+}
+
+// Primele coloane sunt mereu version si label; writeRow(out, record) scrie
+// restul randului, in ordinea din `columns`
+template <typename Record, typename WriteRow>
+void writeCsv(std::ostream& out, const std::string& columns, const std::vector<Record>& records,
+    const std::string& label, WriteRow&& writeRow) {
+    out << "version,label," << columns << "\n";
+    for (const auto& record : records) {
+        out << REGEX_AFD_VERSION << "," << label << ",";
+        writeRow(out, record);
+        out << "\n";
+    }
+}
+
+}
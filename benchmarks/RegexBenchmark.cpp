@@ -0,0 +1,295 @@
+﻿// Benchmark pentru pipeline-ul expresie regulata -> AFD.
+// Masoara separat fiecare etapa (RegexAst::parse, buildLambdaNFA, toDFA,
+// minimize, GlushkovMatcher) si debitul CheckWord /
+// CheckWords / motorul bit-paralel in octeti/s,
+// pe un corpus generat de expresii de marimi si forme diferite.
+//
+// Utilizare: regex_benchmark [--out fisier] [--label text] [--quick] [--format csv|json] [--threads n]
+#include <algorithm>
+#include <bitset>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DeterministicFiniteAutomaton.h"
+#include "GlushkovMatcher.h"
+#include "LambdaNFA.h"
+#include "RegexParser.h"
+#include "BenchmarkCommon.h"
+
+namespace {
+
+using benchmark::measure;
+using benchmark::sink;
+
+struct Pattern {
+    std::string shape;
+    size_t size;
+    std::string infix;  // aceeasi expresie in sintaxa RegexAst::parse
+    std::string polish; // forma acceptata de buildLambdaNFA: litere, '.', '|', '*'
+    std::string alphabet;
+};
+
+struct Record {
+    std::string shape;
+    size_t size;
+    std::string stage;
+    uint64_t iterations;
+    double nsPerOp;
+    uint64_t bytes;       // octeti procesati per operatie (0 pentru etapele de constructie)
+    size_t nfaStates;
+    size_t dfaStates;
+};
+
+char letter(size_t i) {
+    return static_cast<char>('a' + i % 8);
+}
+
+// abc...: o concatenare lunga de litere
+Pattern literalChain(size_t n) {
+    Pattern pattern{ "literal", n, "", "", "abcdefgh" };
+    for (size_t i = 0; i < n; ++i) {
+        pattern.infix += letter(i);
+        pattern.polish += letter(i);
+        if (i > 0) pattern.polish += '.';
+    }
+    return pattern;
+}
+
+// a*b*c*...: multe stelari concatenate, cu multe λ-tranzitii
+Pattern starChain(size_t n) {
+    Pattern pattern{ "star-chain", n, "", "", "abcdefgh" };
+    for (size_t i = 0; i < n; ++i) {
+        pattern.infix += letter(i);
+        pattern.infix += '*';
+        pattern.polish += letter(i);
+        pattern.polish += '*';
+        if (i > 0) pattern.polish += '.';
+    }
+    return pattern;
+}
+
+// a|b|c|...: alternare larga
+Pattern alternation(size_t n) {
+    Pattern pattern{ "alternation", n, "", "", "abcdefgh" };
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0) pattern.infix += '|';
+        pattern.infix += letter(i);
+        pattern.polish += letter(i);
+        if (i > 0) pattern.polish += '|';
+    }
+    return pattern;
+}
+
+// (a|b)*a(a|b)^k: AFD minimal cu 2^(k+1) stari
+Pattern pathological(size_t k) {
+    Pattern pattern{ "pathological", k, "(a|b)*a", "ab|*a.", "ab" };
+    for (size_t i = 0; i < k; ++i) {
+        pattern.infix += "(a|b)";
+        pattern.polish += "ab|.";
+    }
+    return pattern;
+}
+
+// ((a*b)*c)*...: stelari imbricate
+Pattern nestedStars(size_t n) {
+    Pattern pattern{ "nested-star", n, "", "a*", "abcdefgh" };
+    pattern.infix = "a*";
+    for (size_t i = 1; i < n; ++i) {
+        pattern.infix = "(" + pattern.infix + letter(i) + ")*";
+        pattern.polish += letter(i);
+        pattern.polish += ".*";
+    }
+    return pattern;
+}
+
+std::vector<Pattern> generateCorpus(bool quick) {
+    std::vector<Pattern> corpus;
+    const std::vector<size_t> sizes = quick ? std::vector<size_t>{ 8, 64 } : std::vector<size_t>{ 8, 64, 256, 1024 };
+    for (size_t n : sizes) {
+        corpus.push_back(literalChain(n));
+        corpus.push_back(starChain(n));
+        corpus.push_back(alternation(n));
+        corpus.push_back(nestedStars(n));
+    }
+    const std::vector<size_t> depths = quick ? std::vector<size_t>{ 4, 8 } : std::vector<size_t>{ 4, 8, 12 };
+    for (size_t k : depths) {
+        corpus.push_back(pathological(k));
+    }
+    return corpus;
+}
+
+// Cuvinte aleatoare: fie din alfabetul tiparului, fie din tot ASCII-ul tiparibil
+std::vector<std::string> generateWords(const std::string& alphabet, size_t totalBytes, std::mt19937& rng) {
+    std::vector<std::string> words;
+    std::uniform_int_distribution<size_t> length(16, 256);
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    size_t produced = 0;
+    while (produced < totalBytes) {
+        std::string word(length(rng), ' ');
+        for (char& symbol : word) symbol = alphabet[pick(rng)];
+        produced += word.size();
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+void benchmarkPattern(const Pattern& pattern, std::mt19937& rng, bool quick, std::vector<Record>& records) {
+    uint64_t iterations = 0;
+    double ns = 0;
+
+    RegexAst ast;
+    ns = measure([&] { RegexAst::parse(pattern.infix, ast); sink += ast.getNodes().size(); }, iterations);
+    records.push_back({ pattern.shape, pattern.size, "RegexAst::parse", iterations, ns, 0, 0, 0 });
+
+    LambdaNFA nfa;
+    ns = measure([&] { nfa = buildLambdaNFA(pattern.polish); sink += nfa.getStateCount(); }, iterations);
+    const size_t nfaStates = nfa.getStateCount();
+    records.push_back({ pattern.shape, pattern.size, "buildLambdaNFA", iterations, ns, 0, nfaStates, 0 });
+
+    DeterministicFiniteAutomaton dfa;
+    ns = measure([&] { dfa = nfa.toDFA(); sink += dfa.getStateCount(); }, iterations);
+    records.push_back({ pattern.shape, pattern.size, "toDFA", iterations, ns, 0, nfaStates, dfa.getStateCount() });
+
+    DeterministicFiniteAutomaton minimal;
+    ns = measure([&] { minimal = dfa.minimize(); sink += minimal.getStateCount(); }, iterations);
+    const size_t dfaStates = minimal.getStateCount();
+    records.push_back({ pattern.shape, pattern.size, "minimize", iterations, ns, 0, nfaStates, dfaStates });
+
+    // Motorul bit-paralel inlocuieste buildLambdaNFA + toDFA + minimize pentru tiparele mici
+    GlushkovMatcher glushkov;
+    const bool smallPattern = GlushkovMatcher::fromPolishNotation(pattern.polish, glushkov);
+    if (smallPattern) {
+        ns = measure([&] {
+            GlushkovMatcher::fromPolishNotation(pattern.polish, glushkov);
+            sink += glushkov.getPositionCount();
+        }, iterations);
+        records.push_back({ pattern.shape, pattern.size, "GlushkovMatcher", iterations, ns, 0, glushkov.getPositionCount(), 0 });
+    }
+
+    const size_t corpusBytes = quick ? (1 << 18) : (1 << 22);
+    const std::string printable = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,;:-_";
+    const struct {
+        const char* stage;
+        const char* batchStage;
+        const char* bitParallelStage;
+        std::string alphabet;
+    } inputs[] = {
+        { "CheckWord/alphabet", "CheckWords/alphabet", "BitParallel/alphabet", pattern.alphabet },
+        { "CheckWord/printable", "CheckWords/printable", "BitParallel/printable", printable },
+    };
+    for (const auto& [stage, batchStage, bitParallelStage, alphabet] : inputs) {
+        std::vector<std::string> words = generateWords(alphabet, corpusBytes, rng);
+        uint64_t bytes = 0;
+        for (const auto& word : words) bytes += word.size();
+
+        ns = measure([&] {
+            uint64_t accepted = 0;
+            for (const auto& word : words) accepted += minimal.CheckWord(word);
+            sink += accepted;
+        }, iterations);
+        records.push_back({ pattern.shape, pattern.size, stage, iterations, ns, bytes, nfaStates, dfaStates });
+
+        // Acelasi corpus prin CheckWords, pentru comparatie directa cu calea pe un cuvant
+        const std::vector<std::string_view> views(words.begin(), words.end());
+        ns = measure([&] {
+            uint64_t accepted = 0;
+            for (uint64_t bits : minimal.CheckWords(views)) accepted += std::bitset<64>(bits).count();
+            sink += accepted;
+        }, iterations);
+        records.push_back({ pattern.shape, pattern.size, batchStage, iterations, ns, bytes, nfaStates, dfaStates });
+
+        if (smallPattern) {
+            ns = measure([&] {
+                uint64_t accepted = 0;
+                for (const auto& word : words) accepted += glushkov.CheckWord(word);
+                sink += accepted;
+            }, iterations);
+            records.push_back({ pattern.shape, pattern.size, bitParallelStage, iterations, ns, bytes, nfaStates, dfaStates });
+        }
+    }
+}
+
+// Scalarea constructiei submultimilor: acelasi AFN, cu 1, 2, 4, ..., maxThreads fire
+void benchmarkThreads(const Pattern& pattern, unsigned maxThreads, std::vector<Record>& records) {
+    const LambdaNFA nfa = buildLambdaNFA(pattern.polish);
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    uint64_t iterations = 0;
+    for (unsigned threads : threadCounts) {
+        size_t dfaStates = 0;
+        double ns = measure([&] { dfaStates = nfa.determinize(threads).sets.size(); sink += dfaStates; }, iterations);
+        records.push_back({ pattern.shape, pattern.size, "determinize/threads=" + std::to_string(threads), iterations, ns, 0,
+            nfa.getStateCount(), dfaStates });
+    }
+}
+
+double bytesPerSecond(const Record& record) {
+    return benchmark::bytesPerSecond(record.bytes, record.nsPerOp);
+}
+
+void writeCsv(std::ostream& out, const std::vector<Record>& records, const std::string& label) {
+    benchmark::writeCsv(out, "shape,size,stage,iterations,ns_per_op,bytes_per_op,bytes_per_sec,nfa_states,dfa_states",
+        records, label, [](std::ostream& row, const Record& record) {
+            row << record.shape << "," << record.size << "," << record.stage << "," << record.iterations << ","
+                << record.nsPerOp << "," << record.bytes << "," << bytesPerSecond(record) << ","
+                << record.nfaStates << "," << record.dfaStates;
+        });
+}
+
+void writeJson(std::ostream& out, const std::vector<Record>& records, const std::string& label) {
+    out << "{\n  \"version\": \"" << REGEX_AFD_VERSION << "\",\n  \"label\": \"" << label << "\",\n  \"results\": [\n";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const Record& record = records[i];
+        out << "    {\"shape\": \"" << record.shape << "\", \"size\": " << record.size
+            << ", \"stage\": \"" << record.stage << "\", \"iterations\": " << record.iterations
+            << ", \"ns_per_op\": " << record.nsPerOp << ", \"bytes_per_op\": " << record.bytes
+            << ", \"bytes_per_sec\": " << bytesPerSecond(record) << ", \"nfa_states\": " << record.nfaStates
+            << ", \"dfa_states\": " << record.dfaStates << "}" << (i + 1 < records.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    benchmark::Options options;
+    std::string format = "csv";
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    const bool parsed = benchmark::parseOptions(argc, argv, options, " [--format csv|json] [--threads n]",
+        [&](const std::string& argument, int& i) {
+            if (argument == "--format" && i + 1 < argc) format = argv[++i];
+            else if (argument == "--threads" && i + 1 < argc) maxThreads = std::max(1, std::atoi(argv[++i]));
+            else return false;
+            return true;
+        });
+    if (!parsed) {
+        return 1;
+    }
+    if (format != "csv" && format != "json") {
+        std::cerr << "Format necunoscut: " << format << "\n";
+        return 1;
+    }
+
+    std::mt19937 rng(12345); // aceeasi samanta, acelasi corpus intre versiuni
+    std::vector<Record> records;
+    for (const Pattern& pattern : generateCorpus(options.quick)) {
+        std::cerr << "[" << pattern.shape << " " << pattern.size << "]\n";
+        benchmarkPattern(pattern, rng, options.quick, records);
+    }
+    std::cerr << "[fire 1.." << maxThreads << "]\n";
+    benchmarkThreads(pathological(options.quick ? 10 : 14), maxThreads, records);
+
+    const bool written = benchmark::writeOutput(options, [&](std::ostream& out) {
+        if (format == "json") writeJson(out, records, options.label);
+        else writeCsv(out, records, options.label);
+    });
+    return written ? 0 : 1;
+}
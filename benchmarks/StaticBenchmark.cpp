@@ -0,0 +1,153 @@
+﻿// Benchmark pentru automatele construite la compilare (StaticRegex.h).
+// Pentru fiecare tipar compara StaticAutomaton::CheckWord cu CheckWord pe AFD-ul
+// construit la rulare din aceeasi expresie infixata (LambdaNFA::fromExpression),
+// dupa ce verifica faptul ca ambele dau
+// acelasi raspuns pe acelasi corpus. Raporteaza si costul constructiei la rulare,
+// pe care varianta statica il elimina.
+//
+// Utilizare: regex_static_benchmark [--out fisier] [--label text] [--quick]
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "DeterministicFiniteAutomaton.h"
+#include "LambdaNFA.h"
+#include "StaticRegex.h"
+#include "BenchmarkCommon.h"
+
+namespace {
+
+using benchmark::measure;
+using benchmark::sink;
+
+constexpr auto kOptional = StaticAutomaton<16>::compile("a(b|c)*");
+constexpr auto kRepeat = StaticAutomaton<16>::compile("(ab)*c");
+constexpr auto kSuffix = StaticAutomaton<16>::compile("(a|b)*abb");
+constexpr auto kIdentifier = StaticAutomaton<16>::compile("x(y|z)*(0|1)");
+constexpr auto kLiteral = StaticAutomaton<16>::compile("abcdefgh");
+constexpr auto kNested = StaticAutomaton<16>::compile("((a*b)*c)*d");
+static_assert(kOptional.isValid() && kRepeat.isValid() && kSuffix.isValid() && kIdentifier.isValid()
+    && kLiteral.isValid() && kNested.isValid(), "Tiparele statice trebuie sa fie valide");
+
+struct Record {
+    std::string pattern;
+    std::string stage;
+    uint64_t iterations;
+    double nsPerOp;
+    uint64_t bytes;
+};
+
+// Specializat pe automat: tabelul e o constanta cunoscuta compilatorului
+template <const auto& Automaton>
+uint64_t countStatic(const std::vector<std::string>& words) {
+    uint64_t accepted = 0;
+    for (const auto& word : words) accepted += Automaton.CheckWord(word);
+    return accepted;
+}
+
+struct Pattern {
+    const char* infix;
+    const char* alphabet;
+    bool (*check)(std::string_view);
+    uint64_t (*count)(const std::vector<std::string>&);
+};
+
+template <const auto& Automaton>
+bool checkStatic(std::string_view word) {
+    return Automaton.CheckWord(word);
+}
+
+template <const auto& Automaton>
+constexpr Pattern makePattern(const char* infix, const char* alphabet) {
+    return { infix, alphabet, checkStatic<Automaton>, countStatic<Automaton> };
+}
+
+const Pattern kPatterns[] = {
+    makePattern<kOptional>("a(b|c)*", "abcd"),
+    makePattern<kRepeat>("(ab)*c", "abc"),
+    makePattern<kSuffix>("(a|b)*abb", "ab"),
+    makePattern<kIdentifier>("x(y|z)*(0|1)", "xyz01"),
+    makePattern<kLiteral>("abcdefgh", "abcdefgh"),
+    makePattern<kNested>("((a*b)*c)*d", "abcd"),
+};
+
+std::vector<std::string> generateWords(const std::string& alphabet, size_t minLength, size_t maxLength,
+    size_t totalBytes, std::mt19937& rng) {
+    std::vector<std::string> words;
+    std::uniform_int_distribution<size_t> length(minLength, maxLength);
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    size_t produced = 0;
+    while (produced < totalBytes) {
+        std::string word(length(rng), ' ');
+        for (char& symbol : word) symbol = alphabet[pick(rng)];
+        produced += word.size() + 1;
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+bool benchmarkPattern(const Pattern& pattern, std::mt19937& rng, bool quick, std::vector<Record>& records) {
+    LambdaNFA nfa;
+    if (!LambdaNFA::fromExpression(pattern.infix, nfa)) {
+        return false;
+    }
+    uint64_t iterations = 0;
+    DeterministicFiniteAutomaton dfa;
+    double ns = measure([&] {
+        LambdaNFA::fromExpression(pattern.infix, nfa);
+        dfa = nfa.toDFA().minimize();
+        sink += dfa.getStateCount();
+    }, iterations);
+    records.push_back({ pattern.infix, "runtime-build", iterations, ns, 0 });
+
+    // Acord pe cuvinte scurte, unde raspunsurile pozitive sunt frecvente
+    const std::string alphabet = std::string(pattern.alphabet) + "q";
+    for (const auto& word : generateWords(alphabet, 0, 12, 1 << 20, rng)) {
+        if (pattern.check(word) != dfa.CheckWord(word)) {
+            std::cerr << "Eroare: Automatul static pentru " << pattern.infix
+                << " difera de CheckWord pe cuvantul " << word << "\n";
+            return false;
+        }
+    }
+
+    const std::vector<std::string> words = generateWords(pattern.alphabet, 16, 256, quick ? (1 << 18) : (1 << 22), rng);
+    uint64_t bytes = 0;
+    for (const auto& word : words) bytes += word.size();
+
+    ns = measure([&] {
+        uint64_t accepted = 0;
+        for (const auto& word : words) accepted += dfa.CheckWord(word);
+        sink += accepted;
+    }, iterations);
+    records.push_back({ pattern.infix, "CheckWord", iterations, ns, bytes });
+
+    ns = measure([&] { sink += pattern.count(words); }, iterations);
+    records.push_back({ pattern.infix, "static", iterations, ns, bytes });
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    benchmark::Options options;
+    if (!benchmark::parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::mt19937 rng(12345);
+    std::vector<Record> records;
+    for (const Pattern& pattern : kPatterns) {
+        std::cerr << "[" << pattern.infix << "]\n";
+        if (!benchmarkPattern(pattern, rng, options.quick, records)) return 1;
+    }
+
+    const bool written = benchmark::writeOutput(options, [&](std::ostream& out) {
+        benchmark::writeCsv(out, "pattern,stage,iterations,ns_per_op,bytes_per_op,bytes_per_sec", records, options.label,
+            [](std::ostream& row, const Record& record) {
+                row << record.pattern << "," << record.stage << "," << record.iterations << "," << record.nsPerOp << ","
+                    << record.bytes << "," << benchmark::bytesPerSecond(record.bytes, record.nsPerOp);
+            });
+    });
+    return written ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+﻿// Fisierele .afd ale PatternCache: o imagine gasita sub numele (hash-ul) unei
+// chei se foloseste doar daca poarta exact acea cheie normalizata. Un automat
+// peste CompileOptions::limits da nullptr, fara intrare si fara fisier.
+#include "CompiledAutomaton.h"
+#include "PatternCache.h"
+#include "RegexParser.h"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "ESEC: " << what << "\n";
+        ++failures;
+    }
+}
+
+// Acelasi nume ca in PatternCache::compile, pentru o expresie ancorata
+std::string imagePath(const std::filesystem::path& directory, const std::string& expression, std::string& key) {
+    RegexAst ast;
+    RegexAst::parse(expression, ast);
+    key = "a:" + ast.toString();
+    const uint64_t hash = HashBytes(key.data(), key.size());
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+    return (directory / (std::string(name) + ".afd")).string();
+}
+
+void testDiskImages(const std::filesystem::path& directory) {
+    {
+        PatternCache cache(1 << 20, directory.string());
+        PatternCache::Handle first = cache.get("ab+");
+        check(first && first->matches("abb"), "compilare ab+");
+        check(cache.getStats().diskLoads == 0, "prima cerere nu vine de pe disc");
+    }
+
+    std::string key;
+    const std::string path = imagePath(directory, "ab+", key);
+    CompiledAutomaton image;
+    std::string storedKey;
+    check(CompiledAutomaton::loadFromFile(path, image, true, nullptr, &storedKey), "imaginea ab+ exista");
+    check(storedKey == key, "imaginea poarta cheia normalizata");
+
+    {
+        PatternCache cache(1 << 20, directory.string());
+        PatternCache::Handle loaded = cache.get("ab+");
+        check(loaded && loaded->matches("ab") && !loaded->matches("a"), "ab+ incarcat de pe disc");
+        check(cache.getStats().diskLoads == 1, "a doua cerere vine de pe disc");
+    }
+
+    // Coliziune simulata: imaginea lui ab+ sub numele cheii lui cd
+    std::string otherKey;
+    const std::string otherPath = imagePath(directory, "cd", otherKey);
+    std::filesystem::copy_file(path, otherPath, std::filesystem::copy_options::overwrite_existing);
+    {
+        PatternCache cache(1 << 20, directory.string());
+        PatternCache::Handle collided = cache.get("cd");
+        check(collided && collided->matches("cd") && !collided->matches("ab"), "cheie diferita: recompilat");
+        check(cache.getStats().diskLoads == 0, "imaginea altei chei nu se incarca");
+    }
+    check(CompiledAutomaton::loadFromFile(otherPath, image, true, nullptr, &storedKey) && storedKey == otherKey,
+        "imaginea rescrisa cu cheia lui cd");
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        check(entry.path().extension() == ".afd", "fisier temporar ramas: " + entry.path().string());
+    }
+}
+
+// AFD-ul lui (a|b)*a(a|b){20} are 2^21 stari: peste bugetul implicit
+void testLimits(const std::filesystem::path& directory) {
+    PatternCache cache(1 << 20, directory.string());
+    RegexError error;
+    check(!cache.get("(a|b)*a(a|b){20}", PatternCache::CompileOptions(), &error) && !error.message.empty(),
+        "(a|b)*a(a|b){20}: bugetul implicit nu e respectat");
+
+    PatternCache::CompileOptions options;
+    options.limits.maxStates = 4;
+    check(!cache.get("abcdef", options, &error), "abcdef: limita de 4 stari ignorata");
+    check(cache.getStats().entries == 0, "automat peste limite pastrat in cache");
+
+    std::string key;
+    check(!std::filesystem::exists(imagePath(directory, "abcdef", key)), "automat peste limite salvat pe disc");
+    check(cache.get("abcdef") != nullptr, "abcdef: respinsa cu bugetul implicit");
+}
+
+}
+
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "regex_afd_pattern_cache_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    testDiskImages(directory);
+    testLimits(directory);
+
+    std::filesystem::remove_all(directory);
+    if (failures) {
+        std::cerr << failures << " verificari esuate\n";
+        return 1;
+    }
+    std::cout << "ok\n";
+    return 0;
+}
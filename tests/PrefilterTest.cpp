@@ -0,0 +1,101 @@
+﻿// Prefiltrul calculat pe arborele sintactic (analyze) si Searcher::fromExpression:
+// tipul prefiltrului asteptat si aceleasi potriviri ca fara prefiltru.
+#include "LambdaNFA.h"
+#include "Prefilter.h"
+#include "RegexParser.h"
+#include "Searcher.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "ESEC: " << what << "\n";
+        ++failures;
+    }
+}
+
+struct AnalyzeCase {
+    const char* expression;
+    Prefilter::Kind kind;
+    const char* required;
+};
+
+void testAnalyze() {
+    const AnalyzeCase cases[] = {
+        { "abc", Prefilter::Kind::Literal, "abc" },
+        { "a{3}b", Prefilter::Kind::Literal, "aaab" },
+        { "(ab){2,}", Prefilter::Kind::Literal, "abab" },
+        { "\\.com", Prefilter::Kind::Literal, ".com" },
+        { "(foo|foobar)\\d+", Prefilter::Kind::Literal, "foo" },
+        { "x[yz]{2}w", Prefilter::Kind::Byte, "x" },
+        { "[ab]c", Prefilter::Kind::ByteSet, "c" },
+        { "(xy){0,2}z", Prefilter::Kind::ByteSet, "z" },
+        { "(a{0}|b)c", Prefilter::Kind::ByteSet, "c" },
+        // Cuvantul vid sau prea multi octeti de inceput: fara prefiltru
+        { "a*", Prefilter::Kind::None, "" },
+        { "\\w+@x", Prefilter::Kind::None, "@x" },
+    };
+    for (const AnalyzeCase& c : cases) {
+        RegexAst ast;
+        check(RegexAst::parse(c.expression, ast), std::string(c.expression) + ": respinsa");
+        const Prefilter prefilter(analyze(ast));
+        check(prefilter.getKind() == c.kind, std::string(c.expression) + ": prefiltru "
+            + PrefilterKindName(prefilter.getKind()) + ", se astepta " + PrefilterKindName(c.kind));
+        check(prefilter.getRequired() == c.required, std::string(c.expression) + ": subcuvant obligatoriu \""
+            + prefilter.getRequired() + "\"");
+    }
+}
+
+void testSameMatches() {
+    const char* expressions[] = { "abc", "ab+c", "x[yz]{2}w", "(foo|foobar)\\d+", "a{3}b", "[abc]d",
+        "q(u|v)?x", "a|a*b", "(a{0}|b)c", "[a-c]{2}k" };
+    std::mt19937 random(19);
+    const char alphabet[] = "abcxyzwfoqu.1k";
+    for (const char* expression : expressions) {
+        Searcher filtered;
+        Searcher plain;
+        LambdaNFA nfa;
+        if (!Searcher::fromExpression(expression, filtered) || !LambdaNFA::fromExpression(expression, nfa)
+            || !Searcher::fromNFA(nfa, plain)) {
+            check(false, std::string(expression) + ": respinsa");
+            continue;
+        }
+        for (int round = 0; round < 200; ++round) {
+            std::string text(random() % 60, ' ');
+            for (char& symbol : text) symbol = alphabet[random() % (sizeof(alphabet) - 1)];
+            const std::vector<Searcher::Match> a = filtered.findAll(text);
+            const std::vector<Searcher::Match> b = plain.findAll(text);
+            bool same = a.size() == b.size();
+            for (size_t i = 0; same && i < a.size(); ++i) {
+                same = a[i].start == b[i].start && a[i].end == b[i].end;
+            }
+            if (!same) {
+                check(false, std::string(expression) + ": alte potriviri pe \"" + text + "\"");
+                break;
+            }
+        }
+    }
+
+    Searcher searcher;
+    RegexError error;
+    check(!Searcher::fromExpression("a(b", searcher, &error) && error.position == 1, "a(b: eroarea nu e raportata");
+}
+
+}
+
+int main() {
+    testAnalyze();
+    testSameMatches();
+    if (failures) {
+        std::cerr << failures << " verificari esuate\n";
+        return 1;
+    }
+    std::cout << "ok\n";
+    return 0;
+}
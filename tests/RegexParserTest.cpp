@@ -0,0 +1,162 @@
+﻿// Teste de regresie pentru parser (RegexAst::parse) si constructia Thompson
+// (buildLambdaNFA). Iese cu cod nenul daca macar un caz esueaza; rulat de ctest.
+#include "DeterministicFiniteAutomaton.h"
+#include "LambdaNFA.h"
+#include "RegexParser.h"
+#include "Searcher.h"
+#include "StaticRegex.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "ESEC: " << what << "\n";
+        ++failures;
+    }
+}
+
+// Fiecare muchie trebuie sa duca intr-o stare existenta
+bool edgesInRange(const LambdaNFA& nfa) {
+    const uint32_t count = nfa.getStateCount();
+    for (uint32_t state = 0; state < count; ++state) {
+        for (const auto& edge : nfa.getEdges(state)) {
+            if (edge.target >= count) return false;
+        }
+        for (uint32_t target : nfa.getLambdaEdges(state)) {
+            if (target >= count) return false;
+        }
+    }
+    return true;
+}
+
+struct MatchCase {
+    const char* expression;
+    const char* word;
+    bool expected;
+};
+
+void testMatches() {
+    const MatchCase cases[] = {
+        // {0} si {0,0}: operandul dispare, ramane cuvantul vid
+        { "a{0}", "", true }, { "a{0}", "a", false }, { "a{0}b", "b", true }, { "a{0}b", "ab", false },
+        { "(ab|c){0,0}x", "x", true }, { "(ab|c){0,0}x", "cx", false }, { "[a-z]{0}\\d", "7", true },
+        { "x(a{0})*y", "xy", true }, { "a{0}{3}", "", true }, { "(a{0}|b)c", "c", true },
+        // {m}, {m,}, {m,n}
+        { "a{3}", "aaa", true }, { "a{3}", "aa", false }, { "a{3}", "aaaa", false },
+        { "a{2,}", "aa", true }, { "a{2,}", "aaaaaa", true }, { "a{2,}", "a", false },
+        { "a{0,}", "", true }, { "a{1,}", "", false },
+        { "a{1,3}", "a", true }, { "a{1,3}", "aaa", true }, { "a{1,3}", "aaaa", false }, { "a{0,2}", "", true },
+        { "x(y|z){2,3}", "xyzy", true }, { "x(y|z){2,3}", "xy", false }, { "x(y|z){2,3}", "xyzyz", false },
+        // Clase, inclusiv ']' pus primul si '-' la capat
+        { "[]a]", "]", true }, { "[]a]", "a", true }, { "[]a]", "b", false }, { "[^]a]", "b", true },
+        { "[a-]", "-", true }, { "[^a-c]", "d", true }, { "[^a-c]", "b", false }, { "[\\d_]+", "1_2", true },
+        // Secvente escape
+        { "\\x41", "A", true }, { "a\\*", "a*", true }, { "\\(\\)", "()", true }, { "\\n", "\n", true },
+        { "\\d{3}-\\d{4}", "555-1234", true }, { "\\d{3}-\\d{4}", "55-1234", false },
+        { "\\w+", "joe_1", true }, { "\\s", "\t", true }, { "\\S", " ", false }, { "\\.", "x", false },
+        { ".", "\n", false }, { "a b", "a b", true },
+        // Restul sintaxei
+        { "(ab|cd)*", "abcdab", true }, { "(ab|cd)*", "abc", false }, { "a||b", "", true }, { "()", "", true },
+        { "a+b?", "aab", true }, { "a**", "aa", true },
+    };
+    for (const MatchCase& c : cases) {
+        const std::string name = std::string(c.expression) + " pe \"" + c.word + "\"";
+        RegexAst ast;
+        RegexError error;
+        if (!RegexAst::parse(c.expression, ast, &error)) {
+            check(false, name + ": respinsa (" + error.message + ")");
+            continue;
+        }
+        const LambdaNFA nfa = buildLambdaNFA(ast);
+        check(edgesInRange(nfa), name + ": muchie spre o stare inexistenta");
+        check(nfa.toDFA().minimize().CheckWord(c.word) == c.expected, name);
+    }
+}
+
+struct ErrorCase {
+    const char* expression;
+    size_t position;
+};
+
+void testErrors() {
+    const ErrorCase cases[] = {
+        { "(a", 0 }, { "((a)", 0 }, { "a)", 1 }, { "*a", 0 }, { "a|*", 2 }, { "[a", 0 }, { "[z-a]", 1 },
+        { "a{3,1}", 1 }, { "a{1001}", 1 }, { "a{", 2 }, { "a{2", 3 }, { "ab{,3}", 3 }, { "\\q", 0 },
+        { "\\x4", 0 }, { "^a", 0 },
+    };
+    for (const ErrorCase& c : cases) {
+        RegexAst ast;
+        RegexError error;
+        const bool parsed = RegexAst::parse(c.expression, ast, &error);
+        check(!parsed, std::string(c.expression) + ": acceptata");
+        check(parsed || error.position == c.position, std::string(c.expression) + ": coloana "
+            + std::to_string(error.position) + ", se astepta " + std::to_string(c.position));
+        check(parsed || !error.message.empty(), std::string(c.expression) + ": fara mesaj");
+    }
+}
+
+// x{0} lasa in arena operandul nelegat; oglindirea si reuniunea parcurg toate muchiile
+void testThompsonRepeatZero() {
+    const char* expressions[] = { "a{0}b", "(ab|c){0}", "x[0-9]{0,0}y", "(a{0}b)*" };
+    std::vector<LambdaNFA> nfas;
+    for (const char* expression : expressions) {
+        LambdaNFA nfa;
+        if (!LambdaNFA::fromExpression(expression, nfa)) {
+            check(false, std::string(expression) + ": respinsa");
+            continue;
+        }
+        check(edgesInRange(nfa.reversed()), std::string(expression) + ": reversed");
+        check(edgesInRange(nfa.unanchored()), std::string(expression) + ": unanchored");
+        nfas.push_back(nfa);
+    }
+    check(edgesInRange(LambdaNFA::combine(nfas)), "combine peste x{0}");
+
+    LambdaNFA nfa;
+    Searcher searcher;
+    check(LambdaNFA::fromExpression("a{0}b", nfa) && Searcher::fromNFA(nfa, searcher), "a{0}b: respinsa");
+    const std::vector<Searcher::Match> matches = searcher.findAll("xab b");
+    check(matches.size() == 2, "a{0}b: se asteptau doua potriviri in \"xab b\"");
+    for (const Searcher::Match& match : matches) {
+        check(match.end - match.start == 1, "a{0}b: potrivirea trebuie sa fie doar \"b\"");
+    }
+}
+
+// StaticRegex trebuie sa citeasca subsetul lui literal la fel ca RegexAst::parse
+constexpr auto kSpaced = StaticAutomaton<16>::compile("a b+");
+static_assert(kSpaced.isValid() && kSpaced.CheckWord("a bb") && !kSpaced.CheckWord("abb"),
+    "spatiul este literal si in StaticRegex");
+
+void testStaticRegex() {
+    const char* expressions[] = { "a b+", "(x|y z)*", " a", "a(b|c)?d", "(ab)* c" };
+    const char* words[] = { "", "a", "ab", "a b", "a bb", " a", "x", "y z", "xy zx", "ad", "abd", " c", "ab c", "abab c" };
+    for (const char* expression : expressions) {
+        const StaticAutomaton<32> automaton = StaticAutomaton<32>::compile(expression);
+        RegexAst ast;
+        check(automaton.isValid() && RegexAst::parse(expression, ast), std::string(expression) + ": respinsa");
+        const DeterministicFiniteAutomaton dfa = buildLambdaNFA(ast).toDFA().minimize();
+        for (const char* word : words) {
+            check(automaton.CheckWord(word) == dfa.CheckWord(word),
+                std::string(expression) + " pe \"" + word + "\": StaticRegex difera de RegexAst");
+        }
+    }
+}
+
+}
+
+int main() {
+    testMatches();
+    testErrors();
+    testThompsonRepeatZero();
+    testStaticRegex();
+    if (failures) {
+        std::cerr << failures << " verificari esuate\n";
+        return 1;
+    }
+    std::cout << "ok\n";
+    return 0;
+}
@@ -0,0 +1,143 @@
+﻿// Searcher::findAll: aceleasi potriviri leftmost-longest ca o cautare directa,
+// inclusiv peste granitele ferestrelor trecerii inapoi, si timp liniar pe cazul
+// a|a*b peste "aaa..." (o cautare patratica nu s-ar termina in limita de timp).
+#include "DeterministicFiniteAutomaton.h"
+#include "LambdaNFA.h"
+#include "Searcher.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "ESEC: " << what << "\n";
+        ++failures;
+    }
+}
+
+// Din fiecare pozitie, AFD ancorat pana moare; patratic in cel mai rau caz
+std::vector<Searcher::Match> findAllDirect(const CompiledAutomaton& dfa, const std::string& text) {
+    std::vector<Searcher::Match> matches;
+    size_t position = 0;
+    while (position <= text.size()) {
+        size_t start = position;
+        size_t end = std::string::npos;
+        for (; start <= text.size(); ++start) {
+            uint32_t state = dfa.getStartState();
+            if (dfa.isAccepting(state)) end = start;
+            for (size_t i = start; i < text.size() && state != CompiledAutomaton::kDeadState; ++i) {
+                state = dfa.next(state, static_cast<unsigned char>(text[i]));
+                if (dfa.isAccepting(state)) end = i + 1;
+            }
+            if (end != std::string::npos) break;
+        }
+        if (end == std::string::npos) break;
+        matches.push_back({ start, end });
+        position = end > start ? end : start + 1;
+    }
+    return matches;
+}
+
+bool sameMatches(const std::vector<Searcher::Match>& a, const std::vector<Searcher::Match>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].start != b[i].start || a[i].end != b[i].end) return false;
+    }
+    return true;
+}
+
+void compare(const char* expression, const std::string& text, const std::string& what) {
+    LambdaNFA nfa;
+    Searcher plain;
+    Searcher filtered;
+    if (!LambdaNFA::fromExpression(expression, nfa) || !Searcher::fromNFA(nfa, plain)
+        || !Searcher::fromExpression(expression, filtered)) {
+        check(false, std::string(expression) + ": respinsa");
+        return;
+    }
+    const std::vector<Searcher::Match> expected = findAllDirect(nfa.toDFA().minimize().getCompiled(), text);
+    check(sameMatches(plain.findAll(text), expected), std::string(expression) + ": alte potriviri pe " + what);
+    check(sameMatches(filtered.findAll(text), expected), std::string(expression) + ": alte potriviri cu prefiltru pe " + what);
+}
+
+void testRandomTexts() {
+    const char* expressions[] = { "a|a*b", "ab*a|b{2}", "(ab|a)(bc|c)?", "a*", "b?", "(a|b)*c", "c[ab]{2,3}",
+        "a(ba)*", "(a|b)*a(a|b){2}", "x{0}" };
+    std::mt19937 random(5);
+    for (const char* expression : expressions) {
+        for (int round = 0; round < 300; ++round) {
+            std::string text(random() % 40, ' ');
+            for (char& symbol : text) symbol = "abc"[random() % 3];
+            compare(expression, text, "\"" + text + "\"");
+        }
+    }
+}
+
+// Texte mai lungi decat cateva ferestre, cu potriviri lungi care le traverseaza.
+// Potrivirile incep doar la 'b' sau 'c', ca referinta directa sa ramana rapida.
+void testWindows() {
+    std::mt19937 random(7);
+    std::string text;
+    while (text.size() < 300000) {
+        text.append(random() % 200 ? random() % 50 : 70000 + random() % 10, 'a');
+        text += "bc"[random() % 2];
+    }
+    const char* expressions[] = { "ba*", "c(a|b)*b", "ab|ba+c", "b+a?", "[bc]a{3,}" };
+    for (const char* expression : expressions) {
+        compare(expression, text, "textul lung");
+    }
+}
+
+void testLinear() {
+    LambdaNFA nfa;
+    Searcher plain;
+    LambdaNFA::fromExpression("a|a*b", nfa);
+    Searcher::fromNFA(nfa, plain);
+    Searcher filtered;
+    Searcher::fromExpression("a|a*b", filtered);
+
+    const size_t size = 1 << 22;
+    std::string text(size, 'a');
+    for (const Searcher* searcher : std::vector<const Searcher*>{ &plain, &filtered }) {
+        const std::vector<Searcher::Match> matches = searcher->findAll(text);
+        bool ones = matches.size() == size;
+        for (size_t i = 0; ones && i < matches.size(); ++i) ones = matches[i].start == i && matches[i].end == i + 1;
+        check(ones, "a|a*b pe a^n: n potriviri de lungime 1");
+    }
+
+    text.back() = 'b';
+    const std::vector<Searcher::Match> whole = plain.findAll(text);
+    check(whole.size() == 1 && whole[0].start == 0 && whole[0].end == size, "a|a*b pe a^(n-1)b: o singura potrivire");
+}
+
+// AFD-ul lui (a|b)*a(a|b){20} are 2^21 stari: peste bugetul implicit
+void testLimits() {
+    Searcher searcher;
+    RegexError error;
+    check(!Searcher::fromExpression("(a|b)*a(a|b){20}", searcher, &error) && !error.message.empty(),
+          "(a|b)*a(a|b){20}: bugetul implicit nu e respectat");
+    DeterminizeLimits limits;
+    limits.maxStates = 4;
+    check(!Searcher::fromExpression("abcdef", searcher, &error, limits), "abcdef: limita de 4 stari ignorata");
+    check(Searcher::fromExpression("abc", searcher, &error, limits), "abc: respinsa cu 4 stari");
+}
+
+}
+
+int main() {
+    testRandomTexts();
+    testWindows();
+    testLinear();
+    testLimits();
+    if (failures) {
+        std::cerr << failures << " verificari esuate\n";
+        return 1;
+    }
+    std::cout << "ok\n";
+    return 0;
+}
@@ -0,0 +1,52 @@
+﻿// compileRegex<"...">() (StaticRegex.h, doar C++20): acelasi automat ca
+// StaticAutomaton<N>::compile si acelasi limbaj ca AFD-ul construit din RegexAst.
+#include "DeterministicFiniteAutomaton.h"
+#include "LambdaNFA.h"
+#include "StaticRegex.h"
+#include <iostream>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "ESEC: " << what << "\n";
+        ++failures;
+    }
+}
+
+constexpr auto kOptional = compileRegex<"a(b|c)*">();
+constexpr auto kSuffix = compileRegex<"(a|b)*abb", 16>();
+constexpr auto kSpaced = compileRegex<"(ab)* c?">();
+static_assert(kOptional.CheckWord("abcb") && !kOptional.CheckWord("ba"), "compileRegex<a(b|c)*>");
+static_assert(kSuffix.CheckWord("babb") && !kSuffix.CheckWord("abba"), "compileRegex<(a|b)*abb>");
+
+template <typename Automaton>
+void compare(const char* expression, const Automaton& automaton) {
+    const auto same = StaticAutomaton<64>::compile(expression);
+    RegexAst ast;
+    check(same.isValid() && RegexAst::parse(expression, ast), std::string(expression) + ": respinsa");
+    const DeterministicFiniteAutomaton dfa = buildLambdaNFA(ast).toDFA().minimize();
+
+    const char* words[] = { "", "a", "ab", "abc", "abcb", "ba", "abb", "babb", "abba", " c", "ab c", "abab", "c" };
+    for (const char* word : words) {
+        check(automaton.CheckWord(word) == same.CheckWord(word) && automaton.CheckWord(word) == dfa.CheckWord(word),
+            std::string(expression) + " pe \"" + word + "\": compileRegex difera");
+    }
+}
+
+}
+
+int main() {
+    compare("a(b|c)*", kOptional);
+    compare("(a|b)*abb", kSuffix);
+    compare("(ab)* c?", kSpaced);
+    if (failures) {
+        std::cerr << failures << " verificari esuate\n";
+        return 1;
+    }
+    std::cout << "ok\n";
+    return 0;
+}
@@ -0,0 +1,143 @@
+﻿// Tokenizer::tokenize: aceleasi tokenuri ca maximal munch direct (fiecare regula
+// cu AFD-ul ei, pana in starea moarta), inclusiv peste granitele ferestrelor
+// trecerii inapoi, si timp liniar pe regulile "a" si "a*b" peste "aaa..." (varianta
+// patratica nu s-ar termina in limita de timp).
+#include "DeterministicFiniteAutomaton.h"
+#include "LambdaNFA.h"
+#include "Tokenizer.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "ESEC: " << what << "\n";
+        ++failures;
+    }
+}
+
+// Cel mai lung token nevid la fiecare pozitie, la egalitate prima regula;
+// patratic in cel mai rau caz
+size_t tokenizeDirect(const std::vector<Tokenizer::Rule>& rules, const std::string& input, std::vector<Token>& tokens) {
+    std::vector<CompiledAutomaton> dfas;
+    for (const Tokenizer::Rule& rule : rules) {
+        LambdaNFA nfa;
+        LambdaNFA::fromExpression(rule.expression, nfa);
+        dfas.push_back(nfa.toDFA().minimize().getCompiled());
+    }
+
+    size_t position = 0;
+    while (position < input.size()) {
+        size_t bestEnd = position;
+        uint32_t bestRule = Tokenizer::kNoRule;
+        for (size_t r = 0; r < dfas.size(); ++r) {
+            uint32_t state = dfas[r].getStartState();
+            for (size_t i = position; i < input.size() && state != CompiledAutomaton::kDeadState; ++i) {
+                state = dfas[r].next(state, static_cast<unsigned char>(input[i]));
+                if (dfas[r].isAccepting(state) && i + 1 > bestEnd) {
+                    bestEnd = i + 1;
+                    bestRule = rules[r].id;
+                }
+            }
+        }
+        if (bestRule == Tokenizer::kNoRule) break;
+        tokens.push_back({ position, static_cast<uint32_t>(bestEnd - position), bestRule });
+        position = bestEnd;
+    }
+    return position;
+}
+
+void compare(const std::vector<Tokenizer::Rule>& rules, const std::string& input) {
+    Tokenizer tokenizer;
+    if (!Tokenizer::fromRules(rules, tokenizer)) {
+        check(false, "reguli valide");
+        return;
+    }
+    std::vector<Token> tokens;
+    std::vector<Token> expected;
+    const size_t consumed = tokenizer.tokenize(input, tokens);
+    const size_t expectedConsumed = tokenizeDirect(rules, input, expected);
+
+    bool same = consumed == expectedConsumed && tokens.size() == expected.size();
+    for (size_t i = 0; same && i < tokens.size(); ++i) {
+        same = tokens[i].offset == expected[i].offset && tokens[i].length == expected[i].length &&
+            tokens[i].id == expected[i].id;
+    }
+    check(same, "tokenize == maximal munch direct pe \"" + input.substr(0, 40) + "\"");
+}
+
+const std::vector<std::vector<Tokenizer::Rule>> kRuleSets = {
+    { { "a", 1 }, { "a*b", 2 } },
+    { { "ab", 1 }, { "a", 2 }, { "b", 3 }, { "c+", 4 } },
+    { { "(a|b)*c", 1 }, { "a", 2 }, { "b", 3 } },
+    { { "abc", 1 }, { "[a-c]+", 2 } },
+    { { "a+", 1 }, { "a+b", 2 }, { "ba*c", 3 } },
+    { { "(ab)*", 1 }, { "b|c", 2 } },
+};
+
+void testRandomInputs() {
+    std::mt19937 random(7);
+    for (const auto& rules : kRuleSets) {
+        for (int round = 0; round < 200; ++round) {
+            std::string input(random() % 40, 'a');
+            for (char& c : input) c = "abc"[random() % 3];
+            compare(rules, input);
+        }
+    }
+}
+
+// Tokenuri lungi care trec peste granitele de kWindow octeti
+void testWindows() {
+    std::mt19937 random(11);
+    std::string input;
+    while (input.size() < 300000) {
+        if (random() % 200 == 0) input.append(70000, 'a');
+        input += "abc"[random() % 3];
+    }
+    for (const auto& rules : kRuleSets) compare(rules, input);
+}
+
+void testLinear() {
+    Tokenizer tokenizer;
+    Tokenizer::fromRules({ { "a", 1 }, { "a*b", 2 } }, tokenizer);
+
+    const size_t size = 1 << 22;
+    std::string input(size, 'a');
+    std::vector<Token> tokens;
+    bool ones = tokenizer.tokenize(input, tokens) == size && tokens.size() == size;
+    for (size_t i = 0; ones && i < tokens.size(); ++i) ones = tokens[i].offset == i && tokens[i].length == 1 && tokens[i].id == 1;
+    check(ones, "a, a*b pe a^n: n tokenuri de lungime 1");
+
+    input.back() = 'b';
+    tokens.clear();
+    check(tokenizer.tokenize(input, tokens) == size && tokens.size() == 1 && tokens[0].length == size &&
+          tokens[0].id == 2, "a, a*b pe a^(n-1)b: un singur token");
+}
+
+void testLimits() {
+    Tokenizer tokenizer;
+    DeterminizeLimits limits;
+    limits.maxStates = 4;
+    check(!Tokenizer::fromRules({ { "abcdef", 1 } }, tokenizer, limits), "abcdef: limita de 4 stari ignorata");
+    check(!Tokenizer::fromRules({ { "(a|b)*a(a|b){20}", 1 } }, tokenizer), "(a|b)*a(a|b){20}: bugetul implicit nu e respectat");
+}
+
+}
+
+int main() {
+    testRandomInputs();
+    testWindows();
+    testLinear();
+    testLimits();
+    if (failures) {
+        std::cerr << failures << " verificari esuate\n";
+        return 1;
+    }
+    std::cout << "ok\n";
+    return 0;
+}